@@ -0,0 +1,185 @@
+#include "audiobackend.h"
+#include <QMediaDevices>
+#include <QDataStream>
+#include <QDebug>
+#include <algorithm>
+#include <chrono>
+
+// --- FACTORY ---
+std::unique_ptr<AudioBackend> AudioBackend::create(const QString &spec) {
+    if (spec == "null") return std::make_unique<NullBackend>(NullBackend::RealTime);
+    if (spec == "null-fast") return std::make_unique<NullBackend>(NullBackend::Freewheel);
+    if (spec.startsWith("file:")) {
+        return std::make_unique<WavFileBackend>(spec.mid(5), NullBackend::RealTime);
+    }
+    if (spec.startsWith("file-fast:")) {
+        return std::make_unique<WavFileBackend>(spec.mid(10), NullBackend::Freewheel);
+    }
+    if (!spec.isEmpty() && spec != "qt") {
+        qWarning() << "[Audio] Unknown backend" << spec << "- using Qt Multimedia";
+    }
+    return std::make_unique<QtSinkBackend>();
+}
+
+std::unique_ptr<AudioBackend> AudioBackend::createFromEnvironment() {
+    return create(qEnvironmentVariable("XPRESSIVE_AUDIO_BACKEND").trimmed());
+}
+
+// --- QT MULTIMEDIA ---
+QtSinkBackend::QtSinkBackend(QObject *parent)
+    : AudioBackend(parent), m_device(QMediaDevices::defaultAudioOutput()) {}
+
+QtSinkBackend::~QtSinkBackend() {
+    stop();
+}
+
+QAudioFormat QtSinkBackend::negotiateFormat(const QAudioFormat &wanted) const {
+    if (m_device.isFormatSupported(wanted)) return wanted;
+    return m_device.preferredFormat();
+}
+
+bool QtSinkBackend::start(QIODevice *source, const QAudioFormat &format, qint64 bufferBytes) {
+    stop();
+    m_sink = new QAudioSink(m_device, format, this);
+    m_sink->setBufferSize(bufferBytes);
+    connect(m_sink, &QAudioSink::stateChanged, this, &QtSinkBackend::handleStateChanged);
+    m_sink->start(source);
+    return m_sink->error() == QAudio::NoError;
+}
+
+void QtSinkBackend::stop() {
+    if (!m_sink) return;
+    m_sink->stop();
+    delete m_sink;
+    m_sink = nullptr;
+}
+
+qint64 QtSinkBackend::bufferSize() const {
+    return m_sink ? m_sink->bufferSize() : 0;
+}
+
+qint64 QtSinkBackend::bytesQueued() const {
+    return m_sink ? std::max<qint64>(m_sink->bufferSize() - m_sink->bytesFree(), 0) : 0;
+}
+
+void QtSinkBackend::handleStateChanged(QAudio::State state) {
+    if (state == QAudio::IdleState && m_sink->error() == QAudio::UnderrunError) {
+        emit underrun();
+    }
+}
+
+// --- NULL SINK ---
+NullBackend::NullBackend(Pacing pacing, QObject *parent)
+    : AudioBackend(parent), m_pacing(pacing) {}
+
+NullBackend::~NullBackend() {
+    stop();
+}
+
+QString NullBackend::name() const {
+    return m_pacing == RealTime ? QStringLiteral("Null (real time)") : QStringLiteral("Null (freewheel)");
+}
+
+bool NullBackend::start(QIODevice *source, const QAudioFormat &format, qint64 bufferBytes) {
+    stop();
+    if (!source || format.bytesPerFrame() <= 0 || !open(format)) return false;
+
+    m_source = source;
+    m_format = format;
+    m_bufferBytes = bufferBytes;
+    m_bytesPulled.store(0, std::memory_order_relaxed);
+    m_running.store(true, std::memory_order_release);
+    m_thread = std::thread(&NullBackend::pullLoop, this);
+    return true;
+}
+
+void NullBackend::stop() {
+    if (!m_thread.joinable()) return;
+    m_running.store(false, std::memory_order_release);
+    m_thread.join();
+    close();
+}
+
+void NullBackend::pullLoop() {
+    // A quarter of the buffer per pull, like a sound card servicing its periods
+    const int bytesPerFrame = m_format.bytesPerFrame();
+    const qint64 frames = std::max<qint64>(m_bufferBytes / bytesPerFrame / 4, 64);
+    std::vector<char> block((size_t)(frames * bytesPerFrame));
+
+    const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>((double)frames / m_format.sampleRate()));
+    auto deadline = std::chrono::steady_clock::now();
+
+    while (m_running.load(std::memory_order_acquire)) {
+        const qint64 got = m_source->read(block.data(), (qint64)block.size());
+        if (got > 0) {
+            consume(block.data(), got);
+            m_bytesPulled.fetch_add(got, std::memory_order_relaxed);
+        }
+
+        if (m_pacing == RealTime) {
+            deadline += period;
+            std::this_thread::sleep_until(deadline);
+        }
+    }
+}
+
+// --- WAV FILE SINK ---
+WavFileBackend::WavFileBackend(const QString &fileName, Pacing pacing, QObject *parent)
+    : NullBackend(pacing, parent), m_fileName(fileName) {}
+
+WavFileBackend::~WavFileBackend() {
+    // The pull thread calls consume(), so it has to end while we still exist
+    stop();
+}
+
+QString WavFileBackend::name() const {
+    return QStringLiteral("WAV file (%1)").arg(m_fileName);
+}
+
+QByteArray WavFileBackend::wavHeader(const QAudioFormat &format, quint32 dataBytes) {
+    const quint16 channels = (quint16)format.channelCount();
+    const quint16 bytesPerSample = (quint16)format.bytesPerSample();
+
+    QByteArray header;
+    QDataStream out(&header, QIODevice::WriteOnly);
+    out.setByteOrder(QDataStream::LittleEndian);
+
+    out.writeRawData("RIFF", 4);
+    out << (quint32)(36 + dataBytes);
+    out.writeRawData("WAVE", 4);
+    out.writeRawData("fmt ", 4);
+    out << (quint32)16;
+    out << (quint16)(format.sampleFormat() == QAudioFormat::Float ? 3 : 1); // IEEE float / PCM
+    out << channels;
+    out << (quint32)format.sampleRate();
+    out << (quint32)(format.sampleRate() * channels * bytesPerSample);
+    out << (quint16)(channels * bytesPerSample);
+    out << (quint16)(bytesPerSample * 8);
+    out.writeRawData("data", 4);
+    out << dataBytes;
+    return header;
+}
+
+bool WavFileBackend::open(const QAudioFormat &format) {
+    m_file.setFileName(m_fileName);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "[Audio] Cannot open" << m_fileName << "for writing";
+        return false;
+    }
+    m_format = format;
+    m_dataBytes = 0;
+    m_file.write(wavHeader(m_format, 0));
+    return true;
+}
+
+void WavFileBackend::consume(const char *data, qint64 len) {
+    m_dataBytes += (quint32)m_file.write(data, len);
+}
+
+void WavFileBackend::close() {
+    if (!m_file.isOpen()) return;
+    m_file.seek(0);
+    m_file.write(wavHeader(m_format, m_dataBytes));
+    m_file.close();
+}
@@ -0,0 +1,146 @@
+#ifndef AUDIOBACKEND_H
+#define AUDIOBACKEND_H
+
+#include <QObject>
+#include <QIODevice>
+#include <QAudioSink>
+#include <QAudioDevice>
+#include <QAudioFormat>
+#include <QFile>
+#include <QString>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// ==============================================================================
+// AUDIO BACKENDS
+// ==============================================================================
+// Whatever pulls rendered bytes out of SynthEngine. The engine only ever sees
+// this interface, so the same render path runs against a sound card, against
+// nothing at all, or straight into a WAV file on a machine with no audio device.
+//
+// Pick one with SynthEngine::setBackend(), or for a whole run with the
+// XPRESSIVE_AUDIO_BACKEND environment variable (see createFromEnvironment()).
+
+class AudioBackend : public QObject {
+    Q_OBJECT
+public:
+    using QObject::QObject;
+    ~AudioBackend() override = default;
+
+    // Adjust the requested format to one the backend can actually play
+    virtual QAudioFormat negotiateFormat(const QAudioFormat &wanted) const = 0;
+
+    virtual bool start(QIODevice *source, const QAudioFormat &format, qint64 bufferBytes) = 0;
+    virtual void stop() = 0;
+
+    // Bytes the backend holds between the engine and the listener
+    virtual qint64 bufferSize() const = 0;
+    virtual qint64 bytesQueued() const = 0;
+
+    // Freewheeling backends pull as fast as the CPU allows. The engine then
+    // renders synchronously inside readData() instead of through its ring, so
+    // every pull gets real audio and runs are reproducible.
+    virtual bool isFreewheeling() const { return false; }
+
+    virtual QString name() const = 0;
+
+    // "qt" (default), "null", "null-fast", "file:<path>" or "file-fast:<path>"
+    static std::unique_ptr<AudioBackend> create(const QString &spec);
+    static std::unique_ptr<AudioBackend> createFromEnvironment();
+
+signals:
+    void underrun();
+};
+
+// --- QT MULTIMEDIA ---
+// The default output device through QAudioSink.
+class QtSinkBackend : public AudioBackend {
+    Q_OBJECT
+public:
+    explicit QtSinkBackend(QObject *parent = nullptr);
+    ~QtSinkBackend() override;
+
+    QAudioFormat negotiateFormat(const QAudioFormat &wanted) const override;
+    bool start(QIODevice *source, const QAudioFormat &format, qint64 bufferBytes) override;
+    void stop() override;
+    qint64 bufferSize() const override;
+    qint64 bytesQueued() const override;
+    QString name() const override { return QStringLiteral("Qt Multimedia"); }
+
+private slots:
+    void handleStateChanged(QAudio::State state);
+
+private:
+    QAudioDevice m_device;
+    QAudioSink *m_sink = nullptr;
+};
+
+// --- NULL SINK ---
+// Pulls one period at a time on its own thread and throws the bytes away,
+// either paced like a sound card or as fast as possible.
+class NullBackend : public AudioBackend {
+    Q_OBJECT
+public:
+    enum Pacing { RealTime, Freewheel };
+
+    explicit NullBackend(Pacing pacing = RealTime, QObject *parent = nullptr);
+    ~NullBackend() override;
+
+    QAudioFormat negotiateFormat(const QAudioFormat &wanted) const override { return wanted; }
+    bool start(QIODevice *source, const QAudioFormat &format, qint64 bufferBytes) override;
+    void stop() override;
+    qint64 bufferSize() const override { return m_bufferBytes; }
+    qint64 bytesQueued() const override { return 0; }
+    bool isFreewheeling() const override { return m_pacing == Freewheel; }
+    QString name() const override;
+
+    // Bytes pulled since start(), for benchmarks
+    qint64 bytesPulled() const { return m_bytesPulled.load(std::memory_order_relaxed); }
+
+protected:
+    // Called on the pull thread with every block read from the engine
+    virtual void consume(const char *data, qint64 len) { Q_UNUSED(data); Q_UNUSED(len); }
+    virtual bool open(const QAudioFormat &format) { Q_UNUSED(format); return true; }
+    virtual void close() {}
+
+private:
+    void pullLoop();
+
+    Pacing m_pacing;
+    QIODevice *m_source = nullptr;
+    QAudioFormat m_format;
+    qint64 m_bufferBytes = 0;
+    std::thread m_thread;
+    std::atomic<bool> m_running { false };
+    std::atomic<qint64> m_bytesPulled { 0 };
+};
+
+// --- WAV FILE SINK ---
+// A null sink that keeps what it pulls, in the device format. The header is
+// patched with the final sizes when the backend stops.
+class WavFileBackend : public NullBackend {
+    Q_OBJECT
+public:
+    explicit WavFileBackend(const QString &fileName, Pacing pacing = Freewheel, QObject *parent = nullptr);
+    ~WavFileBackend() override;
+
+    QString name() const override;
+
+    // Canonical 44-byte header for any integer or float QAudioFormat
+    static QByteArray wavHeader(const QAudioFormat &format, quint32 dataBytes);
+
+protected:
+    void consume(const char *data, qint64 len) override;
+    bool open(const QAudioFormat &format) override;
+    void close() override;
+
+private:
+    QString m_fileName;
+    QFile m_file;
+    QAudioFormat m_format;
+    quint32 m_dataBytes = 0;
+};
+
+#endif // AUDIOBACKEND_H
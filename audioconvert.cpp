@@ -0,0 +1,219 @@
+#include "audioconvert.h"
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define XPRESSIVE_HAVE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// --- SAMPLE FORMATS ---
+static inline std::uint32_t xorshift(std::uint32_t &s) {
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    return s;
+}
+
+// Uniform float in [0, 1) from the top 23 bits
+static inline float unitFloat(std::uint32_t bits) {
+    const std::uint32_t f = (bits >> 9) | 0x3F800000u;
+    float out;
+    std::memcpy(&out, &f, sizeof(out));
+    return out - 1.0f;
+}
+
+void convertFloatToInt16(const float *in, std::int16_t *out, int count, DitherState &dither) {
+    const float scale = 32767.0f;
+    int i = 0;
+
+#ifdef XPRESSIVE_HAVE_SSE2
+    // Four lanes of xorshift; TPDF dither is the difference of two uniform draws (+-1 LSB)
+    __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dither.seed));
+    const __m128i mantissaOne = _mm_set1_epi32(0x3F800000);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 vscale = _mm_set1_ps(scale);
+    const __m128 lo = _mm_set1_ps(-1.0f), hi = _mm_set1_ps(1.0f);
+
+    auto nextUniform = [&]() {
+        s = _mm_xor_si128(s, _mm_slli_epi32(s, 13));
+        s = _mm_xor_si128(s, _mm_srli_epi32(s, 17));
+        s = _mm_xor_si128(s, _mm_slli_epi32(s, 5));
+        return _mm_sub_ps(_mm_castsi128_ps(_mm_or_si128(_mm_srli_epi32(s, 9), mantissaOne)), one);
+    };
+
+    for (; i + 8 <= count; i += 8) {
+        __m128 a = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + i), lo), hi);
+        __m128 b = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + i + 4), lo), hi);
+        a = _mm_add_ps(_mm_mul_ps(a, vscale), _mm_sub_ps(nextUniform(), nextUniform()));
+        b = _mm_add_ps(_mm_mul_ps(b, vscale), _mm_sub_ps(nextUniform(), nextUniform()));
+        // cvtps rounds to nearest, packs saturates to the int16 range
+        const __m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dither.seed), s);
+#endif
+
+    for (; i < count; ++i) {
+        const float noise = unitFloat(xorshift(dither.seed[0])) - unitFloat(xorshift(dither.seed[1]));
+        float v = std::clamp(in[i], -1.0f, 1.0f) * scale + noise;
+        v = std::clamp(v, -32768.0f, 32767.0f);
+        out[i] = (std::int16_t)(v < 0.0f ? v - 0.5f : v + 0.5f);
+    }
+}
+
+void convertFloatToInt32(const float *in, std::int32_t *out, int count) {
+    // Largest float below 1.0 keeps the product inside the int32 range
+    const float maxIn = 0.99999994f;
+    const float scale = 2147483648.0f;
+    int i = 0;
+
+#ifdef XPRESSIVE_HAVE_SSE2
+    const __m128 lo = _mm_set1_ps(-1.0f), hi = _mm_set1_ps(maxIn);
+    const __m128 vscale = _mm_set1_ps(scale);
+    for (; i + 4 <= count; i += 4) {
+        const __m128 v = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + i), lo), hi);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_cvtps_epi32(_mm_mul_ps(v, vscale)));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        out[i] = (std::int32_t)(std::clamp(in[i], -1.0f, maxIn) * scale);
+    }
+}
+
+void convertFloatToUInt8(const float *in, std::uint8_t *out, int count, DitherState &dither) {
+    for (int i = 0; i < count; ++i) {
+        const float noise = unitFloat(xorshift(dither.seed[0])) - unitFloat(xorshift(dither.seed[1]));
+        const float v = std::clamp(in[i], -1.0f, 1.0f) * 127.0f + 128.0f + noise;
+        out[i] = (std::uint8_t)std::clamp(v + 0.5f, 0.0f, 255.0f);
+    }
+}
+
+// --- STREAMING RESAMPLER ---
+void StreamResampler::setRates(double inputRate, double outputRate) {
+    m_step = (outputRate > 0.0 && inputRate > 0.0) ? inputRate / outputRate : 1.0;
+    reset();
+}
+
+void StreamResampler::reset() {
+    std::fill(m_fifo[0], m_fifo[0] + kFifoSize, 0.0f);
+    std::fill(m_fifo[1], m_fifo[1] + kFifoSize, 0.0f);
+    m_count = 3;
+    m_pos = 1.0;
+}
+
+void StreamResampler::compact(int idx) {
+    // Keep one sample of history behind the read position for the Hermite taps
+    const int drop = idx - 1;
+    if (drop <= 0) return;
+    std::memmove(m_fifo[0], m_fifo[0] + drop, sizeof(float) * (m_count - drop));
+    std::memmove(m_fifo[1], m_fifo[1] + drop, sizeof(float) * (m_count - drop));
+    m_count -= drop;
+    m_pos -= drop;
+}
+
+// --- OVERSAMPLING ---
+static double besselI0(double x) {
+    double sum = 1.0, term = 1.0;
+    for (int k = 1; k < 32; ++k) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+// Kaiser-windowed ideal half-band (cutoff at a quarter of the input rate),
+// normalised to unity gain at DC. Only the odd-offset side taps are stored.
+static const std::array<float, HalfBandDecimator::kTapPairs> &halfBandTaps() {
+    static const std::array<float, HalfBandDecimator::kTapPairs> taps = [] {
+        constexpr int M = HalfBandDecimator::kTapPairs;
+        constexpr double beta = 8.0;
+        const double pi = 3.14159265358979323846;
+        const double halfLength = 2.0 * M;   // Distance from the centre to the window edge
+        std::array<double, M> g {};
+        double sum = 0.0;
+        for (int j = 0; j < M; ++j) {
+            const double k = 2.0 * j + 1.0;
+            const double r = k / halfLength;
+            const double window = besselI0(beta * std::sqrt(std::max(0.0, 1.0 - r * r))) / besselI0(beta);
+            g[j] = std::sin(pi * k / 2.0) / (pi * k) * window;
+            sum += g[j];
+        }
+        std::array<float, M> out {};
+        for (int j = 0; j < M; ++j) out[j] = (float)(g[j] * 0.25 / sum);
+        return out;
+    }();
+    return taps;
+}
+
+void HalfBandDecimator::reset() {
+    std::fill(std::begin(m_even), std::end(m_even), 0.0f);
+    std::fill(std::begin(m_odd), std::end(m_odd), 0.0f);
+}
+
+void HalfBandDecimator::process(const float *in, float *out, int frames) {
+    const int half = frames / 2;
+    float *even = m_even + kHistory;
+    float *odd = m_odd + kHistory;
+    for (int i = 0; i < half; ++i) {
+        even[i] = in[2 * i];
+        odd[i] = in[2 * i + 1];
+    }
+
+    // y[m] = 0.5 * odd[m - M] + sum_j g[j] * (even[m - M + j + 1] + even[m - M - j])
+    const auto &g = halfBandTaps();
+    constexpr int M = kTapPairs;
+    int m = 0;
+
+#ifdef XPRESSIVE_HAVE_SSE2
+    const __m128 centre = _mm_set1_ps(0.5f);
+    for (; m + 4 <= half; m += 4) {
+        __m128 acc = _mm_mul_ps(centre, _mm_loadu_ps(odd + m - M));
+        for (int j = 0; j < M; ++j) {
+            const __m128 pair = _mm_add_ps(_mm_loadu_ps(even + m - M + j + 1), _mm_loadu_ps(even + m - M - j));
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(g[j]), pair));
+        }
+        _mm_storeu_ps(out + m, acc);
+    }
+#endif
+
+    for (; m < half; ++m) {
+        float acc = 0.5f * odd[m - M];
+        for (int j = 0; j < M; ++j) acc += g[j] * (even[m - M + j + 1] + even[m - M - j]);
+        out[m] = acc;
+    }
+
+    // Keep the newest samples as history for the next block
+    std::memmove(m_even, m_even + half, sizeof(float) * kHistory);
+    std::memmove(m_odd, m_odd + half, sizeof(float) * kHistory);
+}
+
+void Oversampler::setFactor(int factor) {
+    m_factor = (factor >= 8) ? 8 : (factor >= 4 ? 4 : (factor >= 2 ? 2 : 1));
+    m_stages = (m_factor == 8) ? 3 : (m_factor == 4 ? 2 : (m_factor == 2 ? 1 : 0));
+    reset();
+}
+
+void Oversampler::reset() {
+    for (auto &stage : m_stage) {
+        stage[0].reset();
+        stage[1].reset();
+    }
+}
+
+void Oversampler::process(float *inL, float *inR, int frames, float *outL, float *outR) {
+    if (m_stages == 0) {
+        std::memcpy(outL, inL, sizeof(float) * frames);
+        std::memcpy(outR, inR, sizeof(float) * frames);
+        return;
+    }
+    // Each stage halves the count in place; the last one writes the output
+    for (int s = 0; s < m_stages; ++s) {
+        const bool last = (s == m_stages - 1);
+        m_stage[s][0].process(inL, last ? outL : inL, frames);
+        m_stage[s][1].process(inR, last ? outR : inR, frames);
+        frames /= 2;
+    }
+}
@@ -0,0 +1,115 @@
+#ifndef AUDIOCONVERT_H
+#define AUDIOCONVERT_H
+
+#include <cstdint>
+#include <algorithm>
+
+// ==============================================================================
+// DEVICE FORMAT CONVERSION
+// ==============================================================================
+// The engine always renders float at its own rate. These helpers turn that into
+// whatever the output device accepted: integer sample formats (with TPDF dither
+// for 16-bit) and a different sample rate. The oversampler brings a source
+// rendered at 2x/4x/8x back down to the engine rate.
+
+// --- SAMPLE FORMATS ---
+// xorshift state for the dither noise, one per output stream
+struct DitherState {
+    std::uint32_t seed[4] = { 0x9E3779B9u, 0x7F4A7C15u, 0x85EBCA6Bu, 0xC2B2AE35u };
+};
+
+void convertFloatToInt16(const float *in, std::int16_t *out, int count, DitherState &dither);
+void convertFloatToInt32(const float *in, std::int32_t *out, int count);
+void convertFloatToUInt8(const float *in, std::uint8_t *out, int count, DitherState &dither);
+
+// --- STREAMING RESAMPLER ---
+// Stereo 4-point Hermite interpolation over a small internal FIFO. pull() asks
+// the supplied fill(left, right, frames) callback for input in fixed-size blocks,
+// so the caller never has to predict how many source frames a device buffer needs.
+class StreamResampler {
+public:
+    static constexpr int kInputBlock = 512;
+
+    void setRates(double inputRate, double outputRate);
+    bool isPassthrough() const { return m_step == 1.0; }
+    void reset();
+
+    template <typename Fill>
+    void pull(float *outL, float *outR, int frames, Fill &&fill) {
+        if (isPassthrough()) {
+            fill(outL, outR, frames);
+            return;
+        }
+        for (int i = 0; i < frames; ++i) {
+            int idx = (int)m_pos;
+            while (idx + 2 >= m_count) {
+                compact(idx);
+                idx = (int)m_pos;
+                fill(m_fifo[0] + m_count, m_fifo[1] + m_count, kInputBlock);
+                m_count += kInputBlock;
+            }
+            const float frac = (float)(m_pos - idx);
+            outL[i] = hermite(m_fifo[0] + idx, frac);
+            outR[i] = hermite(m_fifo[1] + idx, frac);
+            m_pos += m_step;
+        }
+    }
+
+private:
+    static float hermite(const float *x, float frac) {
+        const float xm1 = x[-1], x0 = x[0], x1 = x[1], x2 = x[2];
+        const float c1 = 0.5f * (x1 - xm1);
+        const float c2 = xm1 - 2.5f * x0 + 2.0f * x1 - 0.5f * x2;
+        const float c3 = 0.5f * (x2 - xm1) + 1.5f * (x0 - x1);
+        return ((c3 * frac + c2) * frac + c1) * frac + x0;
+    }
+
+    void compact(int idx);
+
+    static constexpr int kFifoSize = kInputBlock * 2 + 8;
+    float m_fifo[2][kFifoSize] = {};
+    int m_count = 3;        // Starts with a little silent history for the first taps
+    double m_pos = 1.0;
+    double m_step = 1.0;
+};
+
+// --- OVERSAMPLING ---
+// Decimate-by-2 with a 47-tap half-band FIR. Every other tap of a half-band
+// filter is zero, so the input is split into its even and odd phases: the even
+// phase goes through 12 symmetric tap pairs, the odd phase is just the centre
+// tap. Output samples are computed four at a time with SSE where available.
+class HalfBandDecimator {
+public:
+    static constexpr int kTapPairs = 12;
+    static constexpr int kMaxInput = 4096;     // Input frames per process() call
+
+    void reset();
+    // frames must be even and <= kMaxInput; writes frames / 2 samples
+    void process(const float *in, float *out, int frames);
+
+private:
+    static constexpr int kHistory = 2 * kTapPairs;
+    float m_even[kHistory + kMaxInput / 2] = {};
+    float m_odd[kHistory + kMaxInput / 2] = {};
+};
+
+// Stereo cascade of half-band stages: 1x (passthrough), 2x, 4x or 8x
+class Oversampler {
+public:
+    static constexpr int kMaxFactor = 8;
+
+    void setFactor(int factor);
+    int factor() const { return m_factor; }
+    void reset();
+    // frames is the count at the oversampled rate, a multiple of factor() and
+    // at most HalfBandDecimator::kMaxInput. Writes frames / factor() samples.
+    // Scribbles over the inputs.
+    void process(float *inL, float *inR, int frames, float *outL, float *outR);
+
+private:
+    int m_factor = 1;
+    int m_stages = 0;
+    HalfBandDecimator m_stage[3][2];
+};
+
+#endif // AUDIOCONVERT_H
@@ -0,0 +1,116 @@
+#include "audiosource.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+void AudioSource::renderStereo(float *left, float *right, int frames, double t0, double dt) {
+    render(left, frames, t0, dt);
+    std::memcpy(right, left, sizeof(float) * frames);
+}
+
+// --- PER-SAMPLE ADAPTER ---
+FunctionSource::FunctionSource(std::function<double(double)> func, bool stateless)
+    : m_func(std::move(func)), m_stateless(stateless) {}
+
+void FunctionSource::render(float *out, int frames, double t0, double dt) {
+    if (!m_func) {
+        std::fill(out, out + frames, 0.0f);
+        return;
+    }
+    for (int i = 0; i < frames; ++i) {
+        out[i] = (float)m_func(t0 + i * dt);
+    }
+}
+
+// --- DUAL-OUTPUT ADAPTER ---
+StereoFunctionSource::StereoFunctionSource(StereoFunc func, bool stateless)
+    : m_func(std::move(func)), m_stateless(stateless) {}
+
+void StereoFunctionSource::render(float *out, int frames, double t0, double dt) {
+    if (!m_func) {
+        std::fill(out, out + frames, 0.0f);
+        return;
+    }
+    for (int i = 0; i < frames; ++i) {
+        double o1 = 0.0, o2 = 0.0;
+        m_func(t0 + i * dt, o1, o2);
+        out[i] = (float)(0.5 * (o1 + o2));
+    }
+}
+
+void StereoFunctionSource::renderStereo(float *left, float *right, int frames, double t0, double dt) {
+    if (!m_func) {
+        std::fill(left, left + frames, 0.0f);
+        std::fill(right, right + frames, 0.0f);
+        return;
+    }
+    for (int i = 0; i < frames; ++i) {
+        double o1 = 0.0, o2 = 0.0;
+        m_func(t0 + i * dt, o1, o2);
+        left[i] = (float)o1;
+        right[i] = (float)o2;
+    }
+}
+
+// --- SMOOTHED PARAMETER SLOTS ---
+void ParameterBank::reset(int slot, double value) {
+    if (slot < 0 || slot >= kMaxParams) return;
+    if (m_remaining[slot] > 0) --m_rampingSlots;
+    m_value[slot] = m_target[slot] = value;
+    m_remaining[slot] = 0;
+}
+
+void ParameterBank::set(int slot, double target, int rampSamples) {
+    if (slot < 0 || slot >= kMaxParams) return;
+    if (rampSamples <= 0) {
+        reset(slot, target);
+        return;
+    }
+    if (m_remaining[slot] == 0) ++m_rampingSlots;
+    m_target[slot] = target;
+    m_step[slot] = (target - m_value[slot]) / rampSamples;
+    m_remaining[slot] = rampSamples;
+}
+
+void ParameterBank::tick() {
+    for (int i = 0; i < kMaxParams && m_rampingSlots > 0; ++i) {
+        if (m_remaining[i] == 0) continue;
+        if (--m_remaining[i] == 0) {
+            m_value[i] = m_target[i];
+            --m_rampingSlots;
+        } else {
+            m_value[i] += m_step[i];
+        }
+    }
+}
+
+// --- PARAMETRIC ADAPTER ---
+ParametricSource::ParametricSource(ParamFunc func, const std::vector<double> &initialParams)
+    : m_func(std::move(func)) {
+    for (int i = 0; i < (int)initialParams.size(); ++i) m_params.reset(i, initialParams[i]);
+}
+
+void ParametricSource::render(float *out, int frames, double t0, double dt) {
+    if (!m_func) {
+        std::fill(out, out + frames, 0.0f);
+        return;
+    }
+    if (!m_params.isRamping()) {
+        const double *params = m_params.values();
+        for (int i = 0; i < frames; ++i) out[i] = (float)m_func(t0 + i * dt, params);
+        return;
+    }
+    for (int i = 0; i < frames; ++i) {
+        m_params.tick();
+        out[i] = (float)m_func(t0 + i * dt, m_params.values());
+    }
+}
+
+void ParametricSource::applyParameter(const ParamCommand &cmd, double sampleRate) {
+    m_params.set(cmd.slot, cmd.value, (int)std::lround(cmd.rampSeconds * sampleRate));
+}
+
+// --- SILENCE ---
+void SilenceSource::render(float *out, int frames, double, double) {
+    std::fill(out, out + frames, 0.0f);
+}
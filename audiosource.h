@@ -0,0 +1,123 @@
+#ifndef AUDIOSOURCE_H
+#define AUDIOSOURCE_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// ==============================================================================
+// AUDIO SOURCES
+// ==============================================================================
+// A source renders a whole block of mono samples per call. Sample i of a block
+// is the value at time t0 + i * dt, so implementations never divide by the
+// sample rate and can keep their inner loop free of indirect calls.
+//
+// A stateless source's output depends only on t, so render() may be called
+// concurrently for different time ranges (used by offline rendering). One that
+// still needs scratch memory to render hands each extra thread its own copy
+// through cloneForThread().
+//
+// The engine plays everything through renderStereo(). Mono sources inherit the
+// default, which duplicates render() onto both sides; dual-output sources (O1/O2,
+// X/Y) override it and produce both channels in one pass.
+
+// --- PARAMETER COMMANDS ---
+// A few bytes per slider event, carried from the GUI to the render thread by the
+// engine's command queue. Sources that don't take parameters ignore them.
+struct ParamCommand {
+    std::uint16_t slot = 0;
+    float value = 0.0f;
+    float rampSeconds = 0.0f;
+};
+
+class AudioSource {
+public:
+    virtual ~AudioSource() = default;
+    virtual void render(float *out, int frames, double t0, double dt) = 0;
+    virtual void renderStereo(float *left, float *right, int frames, double t0, double dt);
+    virtual bool isStereo() const { return false; }
+    virtual bool isStateless() const { return false; }
+    // nullptr: the source itself is safe to share between render threads
+    virtual std::unique_ptr<AudioSource> cloneForThread() const { return nullptr; }
+    virtual void applyParameter(const ParamCommand &, double /*sampleRate*/) {}
+};
+
+// --- SMOOTHED PARAMETER SLOTS ---
+// Commands land at block boundaries; each slot then moves linearly to its target
+// one sample at a time, so a dragged slider produces no zipper noise.
+class ParameterBank {
+public:
+    static constexpr int kMaxParams = 16;
+
+    void reset(int slot, double value);
+    void set(int slot, double target, int rampSamples);
+    void tick();
+    bool isRamping() const { return m_rampingSlots != 0; }
+    const double *values() const { return m_value.data(); }
+
+private:
+    std::array<double, kMaxParams> m_value {};
+    std::array<double, kMaxParams> m_target {};
+    std::array<double, kMaxParams> m_step {};
+    std::array<int, kMaxParams> m_remaining {};
+    int m_rampingSlots = 0;
+};
+
+// --- PARAMETRIC ADAPTER ---
+// Like FunctionSource, but the patch reads its knobs from a parameter array
+// instead of capturing them, so the same source survives every slider move.
+using ParamFunc = std::function<double(double t, const double *params)>;
+
+class ParametricSource : public AudioSource {
+public:
+    ParametricSource(ParamFunc func, const std::vector<double> &initialParams);
+    void render(float *out, int frames, double t0, double dt) override;
+    void applyParameter(const ParamCommand &cmd, double sampleRate) override;
+
+private:
+    ParamFunc m_func;
+    ParameterBank m_params;
+};
+
+// --- PER-SAMPLE ADAPTER ---
+// Wraps the std::function<double(double)> lambdas the tabs already build.
+class FunctionSource : public AudioSource {
+public:
+    explicit FunctionSource(std::function<double(double)> func, bool stateless = false);
+    void render(float *out, int frames, double t0, double dt) override;
+    bool isStateless() const override { return m_stateless; }
+
+private:
+    std::function<double(double)> m_func;
+    bool m_stateless;
+};
+
+// --- DUAL-OUTPUT ADAPTER ---
+// One call yields both outputs, so O1 and O2 can share intermediate results
+// (sequencer step, gate, envelope) instead of evaluating the graph twice.
+using StereoFunc = std::function<void(double t, double &o1, double &o2)>;
+
+class StereoFunctionSource : public AudioSource {
+public:
+    explicit StereoFunctionSource(StereoFunc func, bool stateless = false);
+    void render(float *out, int frames, double t0, double dt) override;
+    void renderStereo(float *left, float *right, int frames, double t0, double dt) override;
+    bool isStereo() const override { return true; }
+    bool isStateless() const override { return m_stateless; }
+
+private:
+    StereoFunc m_func;
+    bool m_stateless;
+};
+
+// --- SILENCE ---
+// What a tab hands the engine when its preview stops.
+class SilenceSource : public AudioSource {
+public:
+    void render(float *out, int frames, double t0, double dt) override;
+    bool isStateless() const override { return true; }
+};
+
+#endif // AUDIOSOURCE_H
@@ -0,0 +1,91 @@
+#include "enginestatuswidget.h"
+#include <QPainter>
+#include <algorithm>
+
+EngineStatusWidget::EngineStatusWidget(SynthEngine *engine, QWidget *parent)
+    : QWidget(parent), m_engine(engine) {
+    setMinimumHeight(22);
+    setMaximumHeight(22);
+    setToolTip("Preview engine load. Bars show callback render time as a share of the real-time budget "
+               "(<10%, <25%, <50%, <75%, <100%, <150%, <200%, more). Double-click to reset.");
+
+    m_pollTimer = new QTimer(this);
+    m_pollTimer->setInterval(250);
+    connect(m_pollTimer, &QTimer::timeout, this, &EngineStatusWidget::refresh);
+    m_pollTimer->start();
+}
+
+void EngineStatusWidget::refresh() {
+    m_stats = m_engine->stats();
+    update();
+}
+
+void EngineStatusWidget::mouseDoubleClickEvent(QMouseEvent *) {
+    m_engine->resetStats();
+    refresh();
+}
+
+void EngineStatusWidget::paintEvent(QPaintEvent *) {
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor(20, 20, 20));
+
+    // The CPU guard has stepped in: say which slots sound different and why
+    QString guardText;
+    bool guardMuted = false;
+    for (int i = 0; i < EngineStats::kMixerSlots; ++i) {
+        const int stage = m_stats.slotDegrade[i];
+        if (stage == SynthEngine::GuardNormal) continue;
+        const char *what = (stage == SynthEngine::GuardHalfRate) ? "half rate"
+                         : (stage == SynthEngine::GuardQuarterRate) ? "quarter rate" : "MUTED";
+        guardText += QString(guardText.isEmpty() ? "" : ", ") + (i == 0 ? QString("main") : QString("L%1").arg(i)) + " " + what;
+        guardMuted = guardMuted || stage == SynthEngine::GuardMuted;
+    }
+
+    // Green while comfortable, amber past half the budget or once the guard
+    // reduces quality, red once callbacks overrun or the guard mutes something
+    QColor loadColour(0, 255, 120);
+    if (m_stats.cpuLoad > 50.0 || !guardText.isEmpty()) loadColour = QColor(255, 190, 0);
+    if (m_stats.cpuLoad > 90.0 || m_stats.budgetOverruns > 0 || m_stats.ringUnderruns > 0 || guardMuted) loadColour = QColor(255, 60, 60);
+
+    const int h = height();
+    const int barW = 6;
+    const int histW = EngineStats::kHistogramBins * (barW + 1);
+    quint64 maxCount = 1;
+    for (quint64 c : m_stats.histogram) maxCount = std::max(maxCount, c);
+
+    for (int i = 0; i < EngineStats::kHistogramBins; ++i) {
+        const int barH = (int)((h - 4) * (double)m_stats.histogram[i] / maxCount);
+        const QColor binColour = (i < 4) ? QColor(0, 255, 120) : (i == 4 ? QColor(255, 190, 0) : QColor(255, 60, 60));
+        painter.fillRect(QRect(4 + i * (barW + 1), h - 2 - barH, barW, barH), binColour);
+    }
+
+    painter.setPen(loadColour);
+    QString text = QString("%9CPU %1% (peak %2%)  |  overruns %3  |  underruns %4  |  %5 periods, %6 s rendered"
+                           "  |  latency %7 ms (buffer %8 ms)")
+                             .arg(m_stats.cpuLoad, 0, 'f', 1)
+                             .arg(m_stats.peakLoad, 0, 'f', 1)
+                             .arg(m_stats.budgetOverruns)
+                             .arg(m_stats.underruns + m_stats.ringUnderruns)
+                             .arg(m_stats.callbacks)
+                             .arg((double)m_stats.framesRendered / std::max(1, m_stats.sampleRate), 0, 'f', 1)
+                             .arg(m_stats.outputLatencyMs, 0, 'f', 1)
+                             .arg(m_stats.bufferMs, 0, 'f', 1)
+                             .arg(QString(m_stats.realtimePriority ? "RT  " : ""));
+    if (m_stats.activeVoices > 0) {
+        text += QString("  |  %1 voices, %2% each").arg(m_stats.activeVoices).arg(m_stats.perVoiceLoad, 0, 'f', 2);
+    }
+    if (m_stats.activeLayers > 0) {
+        text += QString("  |  %1 layers, main %2%").arg(m_stats.activeLayers).arg(m_stats.slotLoad[0], 0, 'f', 1);
+        for (int i = 1; i < EngineStats::kMixerSlots; ++i) {
+            if (m_stats.slotLoad[i] > 0.0) text += QString(", L%1 %2%").arg(i).arg(m_stats.slotLoad[i], 0, 'f', 1);
+        }
+    }
+    if (!guardText.isEmpty()) {
+        text += "  |  ⚠ CPU guard: " + guardText;
+    }
+    if (m_stats.recording) {
+        text += QString("  |  REC %1 s").arg(m_stats.recordedSeconds, 0, 'f', 1);
+        if (m_stats.recordDroppedBytes > 0) text += QString(" (%1 bytes dropped)").arg(m_stats.recordDroppedBytes);
+    }
+    painter.drawText(rect().adjusted(histW + 12, 0, 0, 0), Qt::AlignVCenter | Qt::AlignLeft, text);
+}
@@ -0,0 +1,30 @@
+#ifndef ENGINESTATUSWIDGET_H
+#define ENGINESTATUSWIDGET_H
+
+#include <QWidget>
+#include <QTimer>
+#include "synthengine.h"
+
+// --- ENGINE STATUS STRIP ---
+// Compact readout of SynthEngine telemetry: smoothed and peak CPU load, overrun
+// and underrun counters and a small render-time histogram. Polls stats() on a
+// timer so the audio thread never has to notify the GUI.
+class EngineStatusWidget : public QWidget {
+    Q_OBJECT
+public:
+    explicit EngineStatusWidget(SynthEngine *engine, QWidget *parent = nullptr);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+
+private slots:
+    void refresh();
+
+private:
+    SynthEngine *m_engine;
+    QTimer *m_pollTimer;
+    EngineStats m_stats;
+};
+
+#endif // ENGINESTATUSWIDGET_H
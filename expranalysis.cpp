@@ -0,0 +1,149 @@
+#include "expranalysis.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+// Rough per-evaluation price of each function relative to an add, from what
+// exprtk does for it: libm calls are the dear ones, the wave shapes other than
+// sinew are an fmod and a few compares
+double funcCost(ExprNode::Func func) {
+    switch (func) {
+    case ExprNode::Sin: case ExprNode::Cos: case ExprNode::Tan:
+    case ExprNode::Exp: case ExprNode::Log: case ExprNode::Log10: case ExprNode::Log2:
+    case ExprNode::Sinew: case ExprNode::Semitone:
+        return 20.0;
+    case ExprNode::Asin: case ExprNode::Acos: case ExprNode::Atan:
+    case ExprNode::Sinh: case ExprNode::Cosh: case ExprNode::Tanh:
+        return 25.0;
+    case ExprNode::Atan2:
+        return 30.0;
+    case ExprNode::Sqrt: case ExprNode::Saww: case ExprNode::Squarew: case ExprNode::Trianglew:
+    case ExprNode::Randv:
+        return 6.0;
+    case ExprNode::Randsv:
+        return 8.0;
+    case ExprNode::Integrate: case ExprNode::Last:
+        return 4.0;
+    case ExprNode::Clamp:
+        return 3.0;
+    default:
+        return 2.0;     // abs, floor and friends, min, max
+    }
+}
+
+double opCost(const ExprNode &node) {
+    switch (node.op) {
+    case ExprNode::Const:
+    case ExprNode::Variable: return 0.0;
+    case ExprNode::Div:      return 4.0;
+    case ExprNode::Mod:      return 10.0;
+    case ExprNode::Pow:      return 25.0;
+    case ExprNode::Call:     return funcCost((ExprNode::Func)node.index);
+    default:                 return 1.0;
+    }
+}
+
+std::string formatBytes(std::size_t bytes) {
+    char buffer[32];
+    if (bytes < 1024) std::snprintf(buffer, sizeof buffer, "%zu B", bytes);
+    else if (bytes < 1024 * 1024) std::snprintf(buffer, sizeof buffer, "%.1f KB", bytes / 1024.0);
+    else std::snprintf(buffer, sizeof buffer, "%.1f MB", bytes / (1024.0 * 1024.0));
+    return buffer;
+}
+
+} // namespace
+
+bool isTranscendental(ExprNode::Func func) {
+    switch (func) {
+    case ExprNode::Sin: case ExprNode::Cos: case ExprNode::Tan:
+    case ExprNode::Asin: case ExprNode::Acos: case ExprNode::Atan: case ExprNode::Atan2:
+    case ExprNode::Sinh: case ExprNode::Cosh: case ExprNode::Tanh:
+    case ExprNode::Exp: case ExprNode::Log: case ExprNode::Log10: case ExprNode::Log2:
+    case ExprNode::Sinew: case ExprNode::Semitone:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// --- ANALYSIS ---
+// One pass down to find what is evaluated (the result and every var body, used
+// or not, since exprtk runs the declaration either way), one pass up in index
+// order for depth and cost. A var body is priced once, where it is declared.
+ExprAnalysis analyzeTree(const ExprTree &tree, std::size_t bytes) {
+    ExprAnalysis analysis;
+    analysis.bytes = bytes;
+    if (!tree.isValid()) return analysis;
+
+    const std::size_t count = tree.nodes.size();
+    std::vector<char> reachable(count, 0), bound(count, 0);
+    reachable[tree.root] = 1;
+    for (const ExprBinding &binding : tree.bindings) {
+        if (binding.node < 0) continue;
+        reachable[binding.node] = 1;
+        bound[binding.node] = 1;
+    }
+    for (std::size_t i = count; i-- > 0;) {
+        if (!reachable[i]) continue;
+        const ExprNode &node = tree.nodes[i];
+        for (std::int32_t child : { node.a, node.b, node.c }) {
+            if (child >= 0) reachable[child] = 1;
+        }
+    }
+
+    std::vector<int> depth(count, 0);
+    std::vector<double> cost(count, 0.0);
+    auto childDepth = [&](std::int32_t child) { return child < 0 ? 0 : (bound[child] ? 1 : depth[child]); };
+    auto childCost = [&](std::int32_t child) { return child < 0 ? 0.0 : (bound[child] ? 0.0 : cost[child]); };
+
+    double boundCost = 0.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!reachable[i]) continue;
+        const ExprNode &node = tree.nodes[i];
+        ++analysis.nodes;
+
+        depth[i] = 1 + std::max({ childDepth(node.a), childDepth(node.b), childDepth(node.c) });
+        if (node.op == ExprNode::Select) {
+            cost[i] = opCost(node) + childCost(node.a) + std::max(childCost(node.b), childCost(node.c));
+        } else {
+            cost[i] = opCost(node) + childCost(node.a) + childCost(node.b) + childCost(node.c);
+        }
+
+        if (node.op == ExprNode::Pow) {
+            ++analysis.powers;
+            ++analysis.transcendentals;
+        } else if (node.op == ExprNode::Call) {
+            const ExprNode::Func func = (ExprNode::Func)node.index;
+            ++analysis.calls[func];
+            if (isTranscendental(func)) ++analysis.transcendentals;
+            if (ExprNode::isStateful(func)) ++analysis.stateful;
+        }
+
+        if (bound[i]) {
+            boundCost += cost[i];
+            analysis.depth = std::max(analysis.depth, depth[i]);
+        }
+    }
+
+    analysis.depth = std::max(analysis.depth, depth[tree.root]);
+    analysis.cost = boundCost + childCost(tree.root);
+    return analysis;
+}
+
+std::vector<std::string> exceededLimits(const ExprAnalysis &analysis, const ExprAnalysisLimits &limits) {
+    std::vector<std::string> exceeded;
+    char buffer[96];
+    if (analysis.bytes > limits.bytes) {
+        exceeded.push_back("size " + formatBytes(analysis.bytes) + " > " + formatBytes(limits.bytes));
+    }
+    if (analysis.depth > limits.depth) {
+        std::snprintf(buffer, sizeof buffer, "depth %d > %d", analysis.depth, limits.depth);
+        exceeded.push_back(buffer);
+    }
+    if (analysis.cost > limits.cost) {
+        std::snprintf(buffer, sizeof buffer, "cost %.0f > %.0f per sample", analysis.cost, limits.cost);
+        exceeded.push_back(buffer);
+    }
+    return exceeded;
+}
@@ -0,0 +1,48 @@
+#ifndef EXPRANALYSIS_H
+#define EXPRANALYSIS_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "exprtree.h"
+
+// ==============================================================================
+// EXPRESSION ANALYSIS
+// ==============================================================================
+// Static figures for a generated expression, so a string that will take LMMS
+// seconds to load or most of a core to run is caught before it is shipped
+// rather than after. Everything is counted on the tree as parsed: copies pasted
+// in twice count twice, a var body counts once (exprtk evaluates it once per
+// sample and every use is a load).
+
+struct ExprAnalysis {
+    std::size_t bytes = 0;          // Length of the source text
+    std::size_t nodes = 0;          // Operators, calls, inputs and numbers
+    int depth = 0;                  // Deepest nesting; a var use is one level
+    int calls[ExprNode::FuncCount] = {};   // Call sites of each function
+    int powers = 0;                 // ^ and pow()
+    int transcendentals = 0;        // Trig, hyperbolic, exp/log, sinew, semitone and powers
+    int stateful = 0;               // integrate() and last()
+    double cost = 0.0;              // Estimated work per sample, about 1 per add,
+                                    // following the dearer side of every ternary
+};
+
+// Past any of these the badge warns. Defaults sit well below the point where
+// LMMS stalls: exprtk's parser refuses nesting beyond 400 by default, and a few
+// hundred kilobytes already take seconds to load.
+struct ExprAnalysisLimits {
+    std::size_t bytes = 128 * 1024;
+    int depth = 300;
+    double cost = 2000.0;
+};
+
+// bytes is the length of the text the tree was parsed from. Non-recursive.
+ExprAnalysis analyzeTree(const ExprTree &tree, std::size_t bytes);
+
+// The limits analysis is past, as short phrases ("depth 812 > 300"); empty
+// when it is within all of them
+std::vector<std::string> exceededLimits(const ExprAnalysis &analysis, const ExprAnalysisLimits &limits);
+
+bool isTranscendental(ExprNode::Func func);
+
+#endif // EXPRANALYSIS_H
@@ -0,0 +1,127 @@
+#include "exprcache.h"
+#include <functional>
+
+ExprCache &ExprCache::shared() {
+    static ExprCache cache;
+    return cache;
+}
+
+ExprCache::ExprCache(std::size_t maxEntries, std::size_t maxBytes, Hasher hasher)
+    : m_maxEntries(maxEntries > 0 ? maxEntries : 1), m_maxBytes(maxBytes), m_hasher(hasher ? hasher : &hashText) {}
+
+std::uint64_t ExprCache::hashText(const std::string &source) {
+    return std::hash<std::string>()(source);
+}
+
+// Roughly what an entry keeps alive: the text, the tree and the bytecode
+std::size_t ExprCache::footprint(const Entry &entry) {
+    std::size_t bytes = sizeof(Entry) + entry.source.capacity() + entry.error.capacity()
+                      + entry.tree.nodes.capacity() * sizeof(ExprNode)
+                      + entry.tree.bindings.capacity() * sizeof(ExprBinding);
+    if (entry.program) bytes += entry.program->memoryUsage();
+    if (entry.m_nativeProgram && entry.m_nativeProgram != entry.program) bytes += entry.m_nativeProgram->memoryUsage();
+    return bytes;
+}
+
+// Drop from the cold end until within both budgets, always keeping the newest
+void ExprCache::evict() {
+    while (m_order.size() > m_maxEntries || (m_bytes > m_maxBytes && m_order.size() > 1)) {
+        const std::shared_ptr<const Entry> &oldest = m_order.back();
+        m_bytes -= footprint(*oldest);
+        m_index.erase(oldest->m_hash);
+        m_order.pop_back();
+    }
+}
+
+std::shared_ptr<const ExprCache::Entry> ExprCache::lookup(const std::string &source) {
+    const std::uint64_t hash = m_hasher(source);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto found = m_index.find(hash);
+        if (found != m_index.end() && (*found->second)->source == source) {
+            m_order.splice(m_order.begin(), m_order, found->second);
+            ++m_hits;
+            return m_order.front();
+        }
+    }
+
+    // Miss: do the work without holding the lock
+    auto entry = std::make_shared<Entry>();
+    entry->source = source;
+    entry->m_hash = hash;
+    ExprParseError parseError;
+    if (ExprTree::parse(source, entry->tree, &parseError)) {
+        entry->analysis = analyzeTree(entry->tree, source.size());
+        entry->program = ExprProgram::fromTree(entry->tree, &entry->error);
+    } else {
+        entry->tree.clear();
+        entry->analysis.bytes = source.size();
+        entry->error = "Parse error at " + std::to_string(parseError.position) + ": " + parseError.message;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_misses;
+    auto found = m_index.find(hash);
+    if (found != m_index.end()) {
+        // Another thread got there first, or a different text with the same hash
+        if ((*found->second)->source == source) {
+            m_order.splice(m_order.begin(), m_order, found->second);
+            return m_order.front();
+        }
+        m_bytes -= footprint(**found->second);
+        m_order.erase(found->second);
+        m_index.erase(found);
+    }
+    m_order.push_front(entry);
+    m_index[hash] = m_order.begin();
+    m_bytes += footprint(*entry);
+    evict();
+    return entry;
+}
+
+std::shared_ptr<const ExprProgram> ExprCache::program(const std::string &source, std::string *error, bool native) {
+    const std::shared_ptr<const Entry> entry = lookup(source);
+    if (!entry->program) {
+        if (error) *error = entry->error;
+        return nullptr;
+    }
+    if (!native) return entry->program;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (entry->m_nativeProgram) return entry->m_nativeProgram;
+    }
+    // No native code on this host (or no room to map it): keep the bytecode
+    std::shared_ptr<const ExprProgram> lowered = ExprProgram::fromTree(entry->tree, nullptr, true);
+    if (!lowered || !lowered->nativeCode()) lowered = entry->program;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (entry->m_nativeProgram) return entry->m_nativeProgram;
+    // Only count it against the budget while the entry is still cached
+    auto found = m_index.find(entry->m_hash);
+    const bool cached = found != m_index.end() && *found->second == entry;
+    if (cached) m_bytes -= footprint(*entry);
+    entry->m_nativeProgram = lowered;
+    if (cached) {
+        m_bytes += footprint(*entry);
+        evict();
+    }
+    return lowered;
+}
+
+void ExprCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_order.clear();
+    m_index.clear();
+    m_bytes = 0;
+}
+
+std::size_t ExprCache::hits() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hits;
+}
+
+std::size_t ExprCache::misses() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_misses;
+}
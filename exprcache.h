@@ -0,0 +1,86 @@
+#ifndef EXPRCACHE_H
+#define EXPRCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "expranalysis.h"
+#include "exprtree.h"
+#include "exprvm.h"
+
+// ==============================================================================
+// COMPILED EXPRESSION CACHE
+// ==============================================================================
+// Parsing, analysing and compiling a string is only done once for each distinct
+// text. Entries are keyed by a hash of the text, checked against the full text
+// on a hit, and evicted least-recently-used once there are too many or they
+// hold too much memory. When a slider goes back to an earlier value, the
+// engine, the scopes and the cost badge all get the earlier program again.
+// A multi-megabyte PCM string is tokenised once, not on every Play.
+//
+// Entries are immutable once returned and may outlive their eviction. The cache
+// locks internally, so any thread may use it, but lookups that miss do their
+// compiling on the caller's thread, like the rest of the GUI work.
+
+class ExprCache {
+public:
+    struct Entry {
+        std::string source;
+        ExprTree tree;                                  // Invalid when it didn't parse
+        ExprAnalysis analysis;
+        std::shared_ptr<const ExprProgram> program;     // nullptr when it didn't parse or compile
+        std::string error;                              // Why program is nullptr
+
+    private:
+        friend class ExprCache;
+        std::uint64_t m_hash = 0;
+        // Lowered on first request, under the cache lock
+        mutable std::shared_ptr<const ExprProgram> m_nativeProgram;
+    };
+
+    // Keys entries; the default is std::hash. Tests pass one that collides.
+    using Hasher = std::uint64_t (*)(const std::string &source);
+    static std::uint64_t hashText(const std::string &source);
+
+    // The one the engine, scopes and analyser share
+    static ExprCache &shared();
+
+    explicit ExprCache(std::size_t maxEntries = 32, std::size_t maxBytes = std::size_t(256) << 20,
+                       Hasher hasher = &ExprCache::hashText);
+    ExprCache(const ExprCache &) = delete;
+    ExprCache &operator=(const ExprCache &) = delete;
+
+    // Parses, analyses and compiles source on a miss. Never nullptr; a text that
+    // doesn't parse is cached too, with its error.
+    std::shared_ptr<const Entry> lookup(const std::string &source);
+    // Shorthand for lookup(source)->program. With native, the copy lowered to
+    // machine code, falling back to the bytecode when it can't be lowered.
+    std::shared_ptr<const ExprProgram> program(const std::string &source, std::string *error = nullptr,
+                                               bool native = false);
+
+    void clear();
+    std::size_t hits() const;
+    std::size_t misses() const;
+
+private:
+    static std::size_t footprint(const Entry &entry);
+    void evict();
+
+    using Order = std::list<std::shared_ptr<const Entry>>;
+
+    mutable std::mutex m_mutex;
+    Order m_order;                                      // Most recent first
+    std::unordered_map<std::uint64_t, Order::iterator> m_index;
+    std::size_t m_maxEntries;
+    std::size_t m_maxBytes;
+    Hasher m_hasher;
+    std::size_t m_bytes = 0;
+    std::size_t m_hits = 0;
+    std::size_t m_misses = 0;
+};
+
+#endif // EXPRCACHE_H
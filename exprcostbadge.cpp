@@ -0,0 +1,101 @@
+#include "exprcostbadge.h"
+#include <QPainter>
+#include <QMenu>
+#include <QInputDialog>
+#include <QLocale>
+#include <QContextMenuEvent>
+#include <QStringList>
+
+ExprCostBadge::ExprCostBadge(QWidget *parent) : QWidget(parent) {
+    setMinimumHeight(22);
+    setMaximumHeight(22);
+    updateToolTip();
+}
+
+void ExprCostBadge::setAnalysis(const ExprAnalysis &analysis) {
+    m_analysis = analysis;
+    m_hasAnalysis = true;
+    m_unparsed.clear();
+    updateToolTip();
+    update();
+}
+
+void ExprCostBadge::setUnparsed(const QString &reason) {
+    m_hasAnalysis = false;
+    m_unparsed = reason;
+    updateToolTip();
+    update();
+}
+
+void ExprCostBadge::contextMenuEvent(QContextMenuEvent *event) {
+    QMenu menu(this);
+    QAction *sizeAction = menu.addAction(QString("Warn above %1...").arg(QLocale().formattedDataSize(m_limits.bytes)));
+    QAction *depthAction = menu.addAction(QString("Warn above depth %1...").arg(m_limits.depth));
+    QAction *costAction = menu.addAction(QString("Warn above cost %1...").arg(m_limits.cost, 0, 'f', 0));
+    QAction *chosen = menu.exec(event->globalPos());
+    if (!chosen) return;
+
+    bool ok = false;
+    if (chosen == sizeAction) {
+        const int kb = QInputDialog::getInt(this, "Expression Limits", "Largest string (KB):",
+                                            (int)(m_limits.bytes / 1024), 1, 1024 * 1024, 16, &ok);
+        if (ok) m_limits.bytes = (std::size_t)kb * 1024;
+    } else if (chosen == depthAction) {
+        const int depth = QInputDialog::getInt(this, "Expression Limits", "Deepest nesting:",
+                                               m_limits.depth, 1, 1000000, 50, &ok);
+        if (ok) m_limits.depth = depth;
+    } else if (chosen == costAction) {
+        const double cost = QInputDialog::getDouble(this, "Expression Limits", "Highest cost per sample:",
+                                                    m_limits.cost, 1.0, 1e9, 0, &ok);
+        if (ok) m_limits.cost = cost;
+    }
+    updateToolTip();
+    update();
+}
+
+void ExprCostBadge::updateToolTip() {
+    QString tip = "Static cost of the generated expression. Cost is roughly one per add per sample, "
+                  "taking the dearer side of every ternary. Right-click to set the warning limits.";
+    if (m_hasAnalysis) {
+        QStringList calls;
+        for (int f = 0; f < ExprNode::FuncCount; ++f) {
+            if (m_analysis.calls[f] > 0) calls << QString("%1 ×%2").arg(QString::fromLatin1(ExprNode::funcName((ExprNode::Func)f))).arg(m_analysis.calls[f]);
+        }
+        if (m_analysis.powers > 0) calls << QString("pow ×%1").arg(m_analysis.powers);
+        if (!calls.isEmpty()) tip += "\n\nCalls: " + calls.join(", ");
+        for (const std::string &reason : exceededLimits(m_analysis, m_limits)) {
+            tip += "\n⚠ " + QString::fromStdString(reason);
+        }
+    }
+    setToolTip(tip);
+}
+
+void ExprCostBadge::paintEvent(QPaintEvent *) {
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor(20, 20, 20));
+
+    QString text;
+    QColor colour(140, 140, 140);
+    if (m_hasAnalysis) {
+        const std::vector<std::string> exceeded = exceededLimits(m_analysis, m_limits);
+        text = QString("%1  |  %2 nodes  |  depth %3  |  %4 transcendental  |  %5 stateful  |  ~%6 ops/sample")
+                   .arg(QLocale().formattedDataSize(m_analysis.bytes))
+                   .arg(m_analysis.nodes)
+                   .arg(m_analysis.depth)
+                   .arg(m_analysis.transcendentals)
+                   .arg(m_analysis.stateful)
+                   .arg(m_analysis.cost, 0, 'f', 0);
+        colour = QColor(0, 255, 120);
+        if (!exceeded.empty()) {
+            QStringList reasons;
+            for (const std::string &reason : exceeded) reasons << QString::fromStdString(reason);
+            text += "  |  ⚠ " + reasons.join(", ");
+            colour = QColor(255, 60, 60);
+        }
+    } else if (!m_unparsed.isEmpty()) {
+        text = "Not measured: " + m_unparsed;
+    }
+
+    painter.setPen(colour);
+    painter.drawText(rect().adjusted(6, 0, -6, 0), Qt::AlignVCenter | Qt::AlignLeft, text);
+}
@@ -0,0 +1,37 @@
+#ifndef EXPRCOSTBADGE_H
+#define EXPRCOSTBADGE_H
+
+#include <QWidget>
+#include <QString>
+#include "expranalysis.h"
+
+// --- EXPRESSION COST BADGE ---
+// One-line readout of analyzeTree() for the string in the status box: size,
+// nodes, nesting depth, transcendental and stateful calls and the estimated
+// per-sample cost. Turns red with the reasons once any limit is passed; the
+// limits are set from its context menu. Tooltip has the per-function counts.
+class ExprCostBadge : public QWidget {
+    Q_OBJECT
+public:
+    explicit ExprCostBadge(QWidget *parent = nullptr);
+
+    void setAnalysis(const ExprAnalysis &analysis);
+    // The text didn't parse, so there is nothing to measure
+    void setUnparsed(const QString &reason);
+
+    const ExprAnalysisLimits &limits() const { return m_limits; }
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void contextMenuEvent(QContextMenuEvent *event) override;
+
+private:
+    void updateToolTip();
+
+    ExprAnalysisLimits m_limits;
+    ExprAnalysis m_analysis;
+    bool m_hasAnalysis = false;
+    QString m_unparsed;
+};
+
+#endif // EXPRCOSTBADGE_H
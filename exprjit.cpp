@@ -0,0 +1,564 @@
+#include "exprjit.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define EXPR_NATIVE_X64 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+#endif
+
+// --- HOST DETECTION ---
+ExprNativeCode::Level ExprNativeCode::hostLevel() {
+#ifdef EXPR_NATIVE_X64
+    static const Level level = []() {
+        unsigned int r[4] = { 0, 0, 0, 0 };   // eax ebx ecx edx
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        const int maxLeaf = info[0];
+        __cpuid(info, 1);
+        for (int i = 0; i < 4; ++i) r[i] = (unsigned int)info[i];
+#else
+        const unsigned int maxLeaf = __get_cpuid_max(0, nullptr);
+        __get_cpuid(1, &r[0], &r[1], &r[2], &r[3]);
+#endif
+        const bool osxsave = (r[2] >> 27) & 1;
+        const bool avx = (r[2] >> 28) & 1;
+        if (!osxsave || !avx || maxLeaf < 7) return Sse2;
+
+        // The OS has to save the upper halves of the ymm registers
+        unsigned long long xcr0;
+#if defined(_MSC_VER)
+        xcr0 = _xgetbv(0);
+        __cpuidex(info, 7, 0);
+        for (int i = 0; i < 4; ++i) r[i] = (unsigned int)info[i];
+#else
+        unsigned int lo, hi;
+        __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+        xcr0 = ((unsigned long long)hi << 32) | lo;
+        __get_cpuid_count(7, 0, &r[0], &r[1], &r[2], &r[3]);
+#endif
+        const bool avx2 = (r[1] >> 5) & 1;
+        return ((xcr0 & 6) == 6 && avx2) ? Avx2 : Sse2;
+    }();
+    return level;
+#else
+    return Unsupported;
+#endif
+}
+
+const char *ExprNativeCode::levelName(Level level) {
+    switch (level) {
+    case Sse2: return "SSE2";
+    case Avx2: return "AVX2";
+    default:   return "Interpreter";
+    }
+}
+
+// --- HELPERS ---
+// Called from the generated code for everything it doesn't lower itself
+void ExprNativeCode::helperExecute(Frame *frame, int pc) {
+    frame->vm->execute(frame->code[pc], frame->lanes, frame->dt);
+}
+
+int ExprNativeCode::helperBranch(Frame *frame, int pc) {
+    return frame->vm->branchTaken(frame->code[pc], frame->lanes) ? 1 : 0;
+}
+
+void ExprNativeCode::run(ExprVM &vm, int lanes, double dt) const {
+    // A multiple of 32 covers whole lane groups at either width and never passes
+    // the end of a register, since kLanes doubles is itself one
+    const std::int64_t laneBytes = ((std::int64_t)lanes * (std::int64_t)sizeof(double) + 31) & ~std::int64_t(31);
+    Frame frame = { vm.m_registers.data(), m_constants.data(), &vm, vm.m_program->m_code.data(), laneBytes, lanes, dt };
+    m_entry(&frame);
+}
+
+#ifdef EXPR_NATIVE_X64
+
+// --- ASSEMBLER ---
+// Register use in the generated function:
+//   rbx  register file     rbp  constant pool     r12  Frame*
+//   rax  byte offset of the current lane group
+//   xmm0-xmm3 / ymm0-ymm3 scratch (none of them callee-saved on any ABI)
+// Every vector loop runs over the block's lanes, rounded up to a whole ymm, so
+// a program whose last() keeps blocks short doesn't pay for all kLanes. Lanes
+// past the block's length hold stale values, which is harmless for element-wise
+// maths; the helpers, whose results can depend on lane count, get the real length.
+class ExprAssembler {
+public:
+    ExprAssembler(const ExprProgram &program, ExprNativeCode &native)
+        : m_program(program), m_native(native), m_avx(native.m_level == ExprNativeCode::Avx2) {}
+    void run();
+    const std::vector<std::uint8_t> &bytes() const { return m_bytes; }
+
+private:
+    using Instr = ExprProgram::Instr;
+    static constexpr std::int32_t kRegisterBytes = ExprProgram::kLanes * sizeof(double);
+
+    // A vector operand: xmm/ymm register, lane group of a VM register, or constant
+    struct Operand {
+        enum Kind { Vector, Lane, Constant };
+        Kind kind;
+        std::int32_t value;
+    };
+    static Operand vec(int index) { return { Operand::Vector, index }; }
+    static Operand lane(std::int32_t reg) { return { Operand::Lane, reg * kRegisterBytes }; }
+    Operand constant(double value);
+    Operand constantBits(std::uint64_t bits);
+
+    enum SseOp : std::uint8_t {
+        MovLoad = 0x10, MovStore = 0x11, Sqrt = 0x51,
+        AndPd = 0x54, AndNPd = 0x55, OrPd = 0x56, XorPd = 0x57,
+        AddPd = 0x58, MulPd = 0x59, SubPd = 0x5C, MinPd = 0x5D, DivPd = 0x5E, MaxPd = 0x5F,
+        CmpPd = 0xC2
+    };
+    enum Compare : std::uint8_t { CmpEq = 0, CmpLt = 1, CmpLe = 2, CmpNe = 4 };
+
+    void byte(std::uint8_t b) { m_bytes.push_back(b); }
+    void dword(std::uint32_t v);
+    void qword(std::uint64_t v);
+
+    // 66 0F-prefixed packed-double instruction, or its VEX.256 form. With
+    // `source` set, vvvv names dst so the AVX form behaves like the SSE one.
+    void packed(std::uint8_t op, int dst, const Operand &src, bool source = true, int map = 1);
+    void modrm(int reg, const Operand &operand);
+
+    void load(int dst, const Operand &src) { packed(MovLoad, dst, src, false); }
+    void store(std::int32_t reg, int src) { packed(MovStore, src, lane(reg), false); }
+    void op(SseOp code, int dst, const Operand &src) { packed(code, dst, src); }
+    void compare(int dst, const Operand &src, Compare predicate) { packed(CmpPd, dst, src); byte(predicate); }
+    void round(int dst, const Operand &src, std::uint8_t mode) { packed(0x09, dst, src, false, 3); byte(mode); }
+
+    void beginLoop();
+    void endLoop();
+    void call(void *function, int pc);
+    void jump(std::uint8_t condition, std::int32_t target);   // 0 = unconditional
+
+    bool emitInstruction(int pc, const Instr &in);
+    bool emitFunc1(const Instr &in);
+    bool emitFunc2(const Instr &in);
+    void emitCompare(const Instr &in, bool immediate);
+
+    const ExprProgram &m_program;
+    ExprNativeCode &m_native;
+    const bool m_avx;
+    std::vector<std::uint8_t> m_bytes;
+    std::vector<std::size_t> m_pcOffset;
+    std::vector<std::pair<std::size_t, std::int32_t>> m_fixups;   // rel32 position, target pc
+    std::size_t m_loopStart = 0;
+};
+
+ExprAssembler::Operand ExprAssembler::constant(double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof bits);
+    return constantBits(bits);
+}
+
+// Pool entries are stored four wide so one unaligned load broadcasts them
+ExprAssembler::Operand ExprAssembler::constantBits(std::uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof value);
+    std::vector<double> &pool = m_native.m_constants;
+    for (size_t i = 0; i < pool.size(); i += 4) {
+        if (std::memcmp(&pool[i], &value, sizeof value) == 0) return { Operand::Constant, (std::int32_t)(i * sizeof(double)) };
+    }
+    const std::int32_t offset = (std::int32_t)(pool.size() * sizeof(double));
+    pool.insert(pool.end(), 4, value);
+    return { Operand::Constant, offset };
+}
+
+void ExprAssembler::dword(std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) byte((std::uint8_t)(v >> (8 * i)));
+}
+
+void ExprAssembler::qword(std::uint64_t v) {
+    dword((std::uint32_t)v);
+    dword((std::uint32_t)(v >> 32));
+}
+
+void ExprAssembler::packed(std::uint8_t op, int dst, const Operand &src, bool source, int map) {
+    const int vvvv = source ? dst : 0;
+    if (m_avx) {
+        // pp = 01 (66), L = 1 (256-bit), vvvv stored inverted
+        const std::uint8_t tail = (std::uint8_t)(((~vvvv & 15) << 3) | 0x04 | 0x01);
+        if (map == 1) {
+            byte(0xC5);
+            byte((std::uint8_t)(0x80 | tail));
+        } else {
+            byte(0xC4);
+            byte((std::uint8_t)(0xE0 | map));
+            byte(tail);
+        }
+    } else {
+        byte(0x66);
+        byte(0x0F);
+        if (map == 2) byte(0x38);
+        if (map == 3) byte(0x3A);
+    }
+    byte(op);
+    modrm(dst, src);
+}
+
+void ExprAssembler::modrm(int reg, const Operand &operand) {
+    switch (operand.kind) {
+    case Operand::Vector:
+        byte((std::uint8_t)(0xC0 | (reg << 3) | operand.value));
+        break;
+    case Operand::Lane:         // [rbx + rax + disp32]
+        byte((std::uint8_t)(0x84 | (reg << 3)));
+        byte(0x03);
+        dword((std::uint32_t)operand.value);
+        break;
+    case Operand::Constant:     // [rbp + disp32]
+        byte((std::uint8_t)(0x85 | (reg << 3)));
+        dword((std::uint32_t)operand.value);
+        break;
+    }
+}
+
+void ExprAssembler::beginLoop() {
+    byte(0x31); byte(0xC0);                         // xor eax, eax
+    m_loopStart = m_bytes.size();
+}
+
+void ExprAssembler::endLoop() {
+    byte(0x48); byte(0x83); byte(0xC0); byte(m_avx ? 32 : 16);     // add rax, step
+    byte(0x49); byte(0x3B); byte(0x44); byte(0x24);
+    byte((std::uint8_t)offsetof(ExprNativeCode::Frame, laneBytes));  // cmp rax, [r12 + laneBytes]
+    byte(0x0F); byte(0x82);                                         // jb loop
+    dword((std::uint32_t)((std::int64_t)m_loopStart - (std::int64_t)(m_bytes.size() + 4)));
+}
+
+void ExprAssembler::call(void *function, int pc) {
+    if (m_avx) { byte(0xC5); byte(0xF8); byte(0x77); }              // vzeroupper
+#if defined(_WIN32)
+    byte(0x4C); byte(0x89); byte(0xE1);                             // mov rcx, r12
+    byte(0xBA); dword((std::uint32_t)pc);                           // mov edx, pc
+#else
+    byte(0x4C); byte(0x89); byte(0xE7);                             // mov rdi, r12
+    byte(0xBE); dword((std::uint32_t)pc);                           // mov esi, pc
+#endif
+    byte(0x48); byte(0xB8); qword((std::uint64_t)(std::uintptr_t)function);   // mov rax, function
+    byte(0xFF); byte(0xD0);                                         // call rax
+}
+
+void ExprAssembler::jump(std::uint8_t condition, std::int32_t target) {
+    if (condition) {
+        byte(0x0F); byte(condition);
+    } else {
+        byte(0xE9);
+    }
+    m_fixups.push_back({ m_bytes.size(), target });
+    dword(0);
+}
+
+void ExprAssembler::emitCompare(const Instr &in, bool immediate) {
+    // Gt and Ge swap their operands into Lt and Le
+    const int base = immediate ? ExprProgram::LtK : ExprProgram::Lt;
+    static const Compare predicates[6] = { CmpLt, CmpLe, CmpLt, CmpLe, CmpEq, CmpNe };
+    const int which = in.op - base;
+    const bool swapped = which == 2 || which == 3;
+    if (immediate) load(1, constant(in.imm));
+    load(3, constant(1.0));
+    beginLoop();
+    if (!swapped) {
+        load(0, lane(in.a));
+        compare(0, immediate ? vec(1) : lane(in.b), predicates[which]);
+    } else if (immediate) {
+        load(0, vec(1));
+        compare(0, lane(in.a), predicates[which]);
+    } else {
+        load(0, lane(in.b));
+        compare(0, lane(in.a), predicates[which]);
+    }
+    op(AndPd, 0, vec(3));
+    store(in.dst, 0);
+    endLoop();
+}
+
+bool ExprAssembler::emitFunc1(const Instr &in) {
+    switch (in.func) {
+    case ExprNode::Abs:
+        load(1, constantBits(0x7FFFFFFFFFFFFFFFull));
+        beginLoop();
+        load(0, lane(in.a));
+        op(AndPd, 0, vec(1));
+        break;
+    case ExprNode::Sqrt:
+        beginLoop();
+        packed(Sqrt, 0, lane(in.a), false);
+        break;
+    case ExprNode::Floor:
+    case ExprNode::Ceil:
+    case ExprNode::Trunc:
+        // roundpd is SSE4.1; the SSE2 level leaves these to the helper
+        if (!m_avx) return false;
+        beginLoop();
+        round(0, lane(in.a), in.func == ExprNode::Floor ? 0x09 : in.func == ExprNode::Ceil ? 0x0A : 0x0B);
+        break;
+    default:
+        return false;
+    }
+    store(in.dst, 0);
+    endLoop();
+    return true;
+}
+
+bool ExprAssembler::emitFunc2(const Instr &in) {
+    // minpd/maxpd return their second operand on NaN; loading b first gives
+    // exactly std::min(a, b) and std::max(a, b)
+    if (in.func != ExprNode::Min && in.func != ExprNode::Max) return false;
+    beginLoop();
+    load(0, lane(in.b));
+    op(in.func == ExprNode::Min ? MinPd : MaxPd, 0, lane(in.a));
+    store(in.dst, 0);
+    endLoop();
+    return true;
+}
+
+bool ExprAssembler::emitInstruction(int pc, const Instr &in) {
+    switch (in.op) {
+    case ExprProgram::JumpNone:
+    case ExprProgram::JumpAll:
+        call((void *)&ExprNativeCode::helperBranch, pc);
+        byte(0x85); byte(0xC0);                     // test eax, eax
+        jump(0x85, in.dst);                         // jnz
+        return true;
+    case ExprProgram::Jump:
+        jump(0, in.dst);
+        return true;
+
+    case ExprProgram::LoadConst:
+        load(1, constant(in.imm));
+        beginLoop();
+        store(in.dst, 1);
+        endLoop();
+        return true;
+    case ExprProgram::Move:
+        if (in.dst == in.a) return true;
+        beginLoop();
+        load(0, lane(in.a));
+        store(in.dst, 0);
+        endLoop();
+        return true;
+    case ExprProgram::Neg:
+        load(1, constant(-0.0));
+        beginLoop();
+        load(0, lane(in.a));
+        op(XorPd, 0, vec(1));
+        store(in.dst, 0);
+        endLoop();
+        return true;
+    case ExprProgram::Not:
+        load(2, constant(0.0));
+        load(3, constant(1.0));
+        beginLoop();
+        load(0, lane(in.a));
+        compare(0, vec(2), CmpEq);
+        op(AndPd, 0, vec(3));
+        store(in.dst, 0);
+        endLoop();
+        return true;
+
+    case ExprProgram::Add:
+    case ExprProgram::Sub:
+    case ExprProgram::Mul:
+    case ExprProgram::Div: {
+        static const SseOp ops[4] = { AddPd, SubPd, MulPd, DivPd };
+        beginLoop();
+        load(0, lane(in.a));
+        op(ops[in.op - ExprProgram::Add], 0, lane(in.b));
+        store(in.dst, 0);
+        endLoop();
+        return true;
+    }
+    case ExprProgram::AddK:
+    case ExprProgram::SubK:
+    case ExprProgram::MulK:
+    case ExprProgram::DivK:
+        load(1, constant(in.imm));
+        beginLoop();
+        load(0, lane(in.a));
+        op(in.op == ExprProgram::AddK ? AddPd : in.op == ExprProgram::SubK ? SubPd : in.op == ExprProgram::MulK ? MulPd : DivPd, 0, vec(1));
+        store(in.dst, 0);
+        endLoop();
+        return true;
+    case ExprProgram::KSub:
+    case ExprProgram::KDiv:
+        load(1, constant(in.imm));
+        beginLoop();
+        load(0, vec(1));
+        op(in.op == ExprProgram::KSub ? SubPd : DivPd, 0, lane(in.a));
+        store(in.dst, 0);
+        endLoop();
+        return true;
+
+    case ExprProgram::Lt: case ExprProgram::Le: case ExprProgram::Gt:
+    case ExprProgram::Ge: case ExprProgram::Eq: case ExprProgram::Ne:
+        emitCompare(in, false);
+        return true;
+    case ExprProgram::LtK: case ExprProgram::LeK: case ExprProgram::GtK:
+    case ExprProgram::GeK: case ExprProgram::EqK: case ExprProgram::NeK:
+        emitCompare(in, true);
+        return true;
+
+    case ExprProgram::And:
+    case ExprProgram::Or:
+        load(2, constant(0.0));
+        load(3, constant(1.0));
+        beginLoop();
+        load(0, lane(in.a));
+        compare(0, vec(2), CmpNe);
+        load(1, lane(in.b));
+        compare(1, vec(2), CmpNe);
+        op(in.op == ExprProgram::And ? AndPd : OrPd, 0, vec(1));
+        op(AndPd, 0, vec(3));
+        store(in.dst, 0);
+        endLoop();
+        return true;
+
+    case ExprProgram::Blend:
+        load(2, constant(0.0));
+        beginLoop();
+        load(0, lane(in.a));
+        compare(0, vec(2), CmpNe);
+        load(1, lane(in.b));
+        op(AndPd, 1, vec(0));
+        op(AndNPd, 0, lane(in.c));
+        op(OrPd, 0, vec(1));
+        store(in.dst, 0);
+        endLoop();
+        return true;
+
+    case ExprProgram::Clamp:
+        // std::min(std::max(b, a), c), operand order chosen for the NaN cases
+        beginLoop();
+        load(0, lane(in.a));
+        op(MaxPd, 0, lane(in.b));
+        load(1, lane(in.c));
+        op(MinPd, 1, vec(0));
+        store(in.dst, 1);
+        endLoop();
+        return true;
+
+    case ExprProgram::Func1:
+        return emitFunc1(in);
+    case ExprProgram::Func2:
+        return emitFunc2(in);
+    default:
+        // Mod, Pow, transcendentals, integrate, last: interpreter helper
+        return false;
+    }
+}
+
+void ExprAssembler::run() {
+    // Prologue: three pushes plus the return address leave rsp 16-byte aligned,
+    // and the 32 bytes below are the Win64 shadow space for helper calls
+    byte(0x53);                                     // push rbx
+    byte(0x55);                                     // push rbp
+    byte(0x41); byte(0x54);                         // push r12
+    byte(0x48); byte(0x83); byte(0xEC); byte(0x20); // sub rsp, 32
+#if defined(_WIN32)
+    byte(0x49); byte(0x89); byte(0xCC);             // mov r12, rcx
+#else
+    byte(0x49); byte(0x89); byte(0xFC);             // mov r12, rdi
+#endif
+    byte(0x49); byte(0x8B); byte(0x5C); byte(0x24); byte((std::uint8_t)offsetof(ExprNativeCode::Frame, registers));  // mov rbx, [r12 + registers]
+    byte(0x49); byte(0x8B); byte(0x6C); byte(0x24); byte((std::uint8_t)offsetof(ExprNativeCode::Frame, constants));  // mov rbp, [r12 + constants]
+
+    const std::vector<Instr> &code = m_program.m_code;
+    m_pcOffset.resize(code.size() + 1);
+    for (size_t pc = 0; pc < code.size(); ++pc) {
+        m_pcOffset[pc] = m_bytes.size();
+        if (!emitInstruction((int)pc, code[pc])) call((void *)&ExprNativeCode::helperExecute, (int)pc);
+    }
+    m_pcOffset[code.size()] = m_bytes.size();
+
+    if (m_avx) { byte(0xC5); byte(0xF8); byte(0x77); }      // vzeroupper
+    byte(0x48); byte(0x83); byte(0xC4); byte(0x20);         // add rsp, 32
+    byte(0x41); byte(0x5C);                                 // pop r12
+    byte(0x5D);                                             // pop rbp
+    byte(0x5B);                                             // pop rbx
+    byte(0xC3);                                             // ret
+
+    for (const auto &fixup : m_fixups) {
+        const std::int64_t rel = (std::int64_t)m_pcOffset[fixup.second] - (std::int64_t)(fixup.first + 4);
+        const std::uint32_t v = (std::uint32_t)(std::int32_t)rel;
+        for (int i = 0; i < 4; ++i) m_bytes[fixup.first + i] = (std::uint8_t)(v >> (8 * i));
+    }
+}
+
+#endif // EXPR_NATIVE_X64
+
+// --- CODE BUFFER ---
+std::shared_ptr<const ExprNativeCode> ExprNativeCode::compile(const ExprProgram &program, Level level) {
+#ifdef EXPR_NATIVE_X64
+    level = std::min(level, hostLevel());
+    if (level == Unsupported || program.m_output < 0) return nullptr;
+
+    std::shared_ptr<ExprNativeCode> native(new ExprNativeCode());
+    native->m_level = level;
+    ExprAssembler assembler(program, *native);
+    assembler.run();
+    const std::vector<std::uint8_t> &bytes = assembler.bytes();
+
+    // Written while read/write, then flipped to read/execute: never both
+    const std::size_t size = bytes.size();
+#if defined(_WIN32)
+    void *memory = VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    if (!memory) return nullptr;
+    std::memcpy(memory, bytes.data(), size);
+    DWORD previous;
+    if (!VirtualProtect(memory, size, PAGE_EXECUTE_READ, &previous)) {
+        VirtualFree(memory, 0, MEM_RELEASE);
+        return nullptr;
+    }
+    FlushInstructionCache(GetCurrentProcess(), memory, size);
+#else
+    void *memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) return nullptr;
+    std::memcpy(memory, bytes.data(), size);
+    if (mprotect(memory, size, PROT_READ | PROT_EXEC) != 0) {
+        munmap(memory, size);
+        return nullptr;
+    }
+#endif
+    native->m_memory = memory;
+    native->m_mappedSize = size;
+    native->m_codeSize = size;
+    native->m_entry = reinterpret_cast<Entry>(memory);
+    return native;
+#else
+    (void)program;
+    (void)level;
+    return nullptr;
+#endif
+}
+
+std::shared_ptr<const ExprProgram> ExprNativeCode::lower(const ExprProgram &program, Level level) {
+    std::shared_ptr<const ExprNativeCode> native = compile(program, level);
+    if (!native) return nullptr;
+    auto lowered = std::make_shared<ExprProgram>(program);
+    lowered->m_native = std::move(native);
+    return lowered;
+}
+
+ExprNativeCode::~ExprNativeCode() {
+    if (!m_memory) return;
+#if defined(_WIN32)
+    VirtualFree(m_memory, 0, MEM_RELEASE);
+#elif defined(EXPR_NATIVE_X64)
+    munmap(m_memory, m_mappedSize);
+#endif
+}
@@ -0,0 +1,77 @@
+#ifndef EXPRJIT_H
+#define EXPRJIT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "exprvm.h"
+
+// ==============================================================================
+// NATIVE EXPRESSION CODE
+// ==============================================================================
+// Optional x86-64 back end for ExprProgram. Each bytecode instruction becomes a
+// straight SSE2 or AVX2 loop over its 128-lane registers, so the interpreter's
+// dispatch disappears for the arithmetic, comparison and select work that
+// dominates big additive and PCM patches. Anything without a short vector form
+// (transcendentals, pow, fmod, integrate, last, the branch tests) calls back
+// into the interpreter for that one instruction, so results are bit-identical
+// to the VM. No assembler dependency: the few encodings needed are emitted by
+// hand into an mmap'd (VirtualAlloc'd on Windows) buffer that is made
+// executable only after it has been written.
+
+class ExprNativeCode {
+public:
+    enum Level { Unsupported, Sse2, Avx2 };
+
+    // What this CPU and OS can run, checked once with cpuid / xgetbv
+    static Level hostLevel();
+    static const char *levelName(Level level);
+
+    // nullptr when the host isn't x86-64 or the buffer can't be mapped; callers
+    // then keep interpreting. level is clamped to hostLevel().
+    static std::shared_ptr<const ExprNativeCode> compile(const ExprProgram &program, Level level = hostLevel());
+    // A copy of program that ExprVM runs through native code of the given
+    // level; nullptr when compile() would fail. Lets tests and benchmarks pit
+    // SSE2 against AVX2 on the same host.
+    static std::shared_ptr<const ExprProgram> lower(const ExprProgram &program, Level level = hostLevel());
+
+    ~ExprNativeCode();
+    ExprNativeCode(const ExprNativeCode &) = delete;
+    ExprNativeCode &operator=(const ExprNativeCode &) = delete;
+
+    Level level() const { return m_level; }
+    std::size_t codeSize() const { return m_codeSize; }
+
+    // Run the program body for one block; the VM has already filled the inputs
+    void run(ExprVM &vm, int lanes, double dt) const;
+
+private:
+    ExprNativeCode() = default;
+
+    // Passed to the generated code and handed back to its helper calls
+    struct Frame {
+        double *registers;
+        const double *constants;
+        ExprVM *vm;
+        const ExprProgram::Instr *code;
+        std::int64_t laneBytes;     // Bytes the vector loops cover: lanes, rounded up to a ymm
+        int lanes;
+        double dt;
+    };
+    using Entry = void (*)(Frame *);
+
+    static void helperExecute(Frame *frame, int pc);
+    static int helperBranch(Frame *frame, int pc);
+
+    friend class ExprAssembler;
+
+    Level m_level = Unsupported;
+    void *m_memory = nullptr;
+    std::size_t m_mappedSize = 0;
+    std::size_t m_codeSize = 0;
+    Entry m_entry = nullptr;
+    std::vector<double> m_constants;
+};
+
+#endif // EXPRJIT_H
@@ -0,0 +1,400 @@
+#include "exproptimize.h"
+#include "exprvm.h"
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// --- SIMPLIFIER ---
+// Rebuilds the tree node by node in index order. Children precede parents, so
+// each node is rewritten after its (already simplified) operands, and a rule
+// only ever looks one or two levels down. Shared nodes stay shared.
+class ExprSimplifier {
+public:
+    ExprSimplifier(const ExprTree &tree, ExprTree &out, const ExprOptimizeOptions &options)
+        : m_tree(tree), m_out(out),
+          m_duration(options.duration > 0.0 ? windowEnd(options.duration) : std::numeric_limits<double>::infinity()) {}
+    void run();
+
+private:
+    // Generators print times with QString::arg (6 significant digits) or to 4
+    // decimals, so a segment that ends exactly at duration can read back a
+    // little later. Widen the window by that rounding so its silence branch
+    // (t < end ? ... : 0) is never mistaken for always-true.
+    static double windowEnd(double duration) { return duration + duration * 1e-5 + 1e-4; }
+
+    std::int32_t constant(double value);
+    bool isConst(std::int32_t node, double &value) const;
+    bool hasValue(std::int32_t node, double value) const;
+    bool isTime(std::int32_t node) const;
+    bool isBoolean(std::int32_t node) const;
+    bool isTimeOverZero(std::int32_t node) const;
+
+    std::int32_t make(ExprNode::Op op, std::int32_t a, std::int32_t b = -1, std::int32_t c = -1, int index = 0);
+    std::int32_t unary(ExprNode::Op op, std::int32_t a);
+    std::int32_t binary(ExprNode::Op op, std::int32_t a, std::int32_t b);
+    std::int32_t compareTime(ExprNode::Op op, std::int32_t a, std::int32_t b);
+    std::int32_t select(std::int32_t a, std::int32_t b, std::int32_t c);
+    std::int32_t call(ExprNode::Func func, std::int32_t a, std::int32_t b, std::int32_t c);
+
+    const ExprTree &m_tree;
+    ExprTree &m_out;
+    const double m_duration;    // Infinity when open-ended
+};
+
+std::int32_t ExprSimplifier::constant(double value) {
+    return m_out.addConst(value == 0.0 ? 0.0 : value);     // No -0 in printed output
+}
+
+bool ExprSimplifier::isConst(std::int32_t node, double &value) const {
+    const ExprNode &n = m_out.nodes[node];
+    if (n.op != ExprNode::Const) return false;
+    value = n.value;
+    return true;
+}
+
+bool ExprSimplifier::hasValue(std::int32_t node, double value) const {
+    double v;
+    return isConst(node, v) && v == value;
+}
+
+bool ExprSimplifier::isTime(std::int32_t node) const {
+    const ExprNode &n = m_out.nodes[node];
+    return n.op == ExprNode::Variable && n.index == ExprNode::Time;
+}
+
+// Always exactly 0 or 1
+bool ExprSimplifier::isBoolean(std::int32_t node) const {
+    const ExprNode &n = m_out.nodes[node];
+    if (n.op == ExprNode::Const) return n.value == 0.0 || n.value == 1.0;
+    return n.op == ExprNode::Not || (n.op >= ExprNode::Lt && n.op <= ExprNode::Or);
+}
+
+// `t / 0`: what an attack or fade time of zero turns `t / attack` into
+bool ExprSimplifier::isTimeOverZero(std::int32_t node) const {
+    const ExprNode &n = m_out.nodes[node];
+    return n.op == ExprNode::Div && isTime(n.a) && hasValue(n.b, 0.0);
+}
+
+std::int32_t ExprSimplifier::make(ExprNode::Op op, std::int32_t a, std::int32_t b, std::int32_t c, int index) {
+    ExprNode node;
+    node.op = op;
+    node.index = (std::uint8_t)index;
+    node.a = a;
+    node.b = b;
+    node.c = c;
+    return m_out.add(node);
+}
+
+std::int32_t ExprSimplifier::unary(ExprNode::Op op, std::int32_t a) {
+    double x;
+    if (isConst(a, x)) return constant(op == ExprNode::Neg ? -x : (x == 0.0 ? 1.0 : 0.0));
+    const ExprNode &n = m_out.nodes[a];
+    if (op == ExprNode::Neg && n.op == ExprNode::Neg) return n.a;
+    return make(op, a);
+}
+
+std::int32_t ExprSimplifier::binary(ExprNode::Op op, std::int32_t a, std::int32_t b) {
+    double x = 0.0, y = 0.0;
+    const bool ka = isConst(a, x);
+    const bool kb = isConst(b, y);
+
+    // Constant folding, with the VM's own semantics
+    if (ka && kb) {
+        double r = 0.0;
+        switch (op) {
+        case ExprNode::Add: r = x + y; break;
+        case ExprNode::Sub: r = x - y; break;
+        case ExprNode::Mul: r = x * y; break;
+        case ExprNode::Div: r = x / y; break;
+        case ExprNode::Mod: r = std::fmod(x, y); break;
+        case ExprNode::Pow: r = std::pow(x, y); break;
+        case ExprNode::Lt:  r = x < y; break;
+        case ExprNode::Le:  r = x <= y; break;
+        case ExprNode::Gt:  r = x > y; break;
+        case ExprNode::Ge:  r = x >= y; break;
+        case ExprNode::Eq:  r = x == y; break;
+        case ExprNode::Ne:  r = x != y; break;
+        case ExprNode::And: r = x != 0.0 && y != 0.0; break;
+        case ExprNode::Or:  r = x != 0.0 || y != 0.0; break;
+        default: break;
+        }
+        if (std::isfinite(r)) return constant(r);
+    }
+
+    // Identities, zeros and strength reduction
+    switch (op) {
+    case ExprNode::Add:
+        if (ka && x == 0.0) return b;
+        if (kb && y == 0.0) return a;
+        break;
+    case ExprNode::Sub:
+        if (kb && y == 0.0) return a;
+        if (ka && x == 0.0) return unary(ExprNode::Neg, b);
+        break;
+    case ExprNode::Mul:
+        if ((ka && x == 0.0) || (kb && y == 0.0)) return constant(0.0);
+        if (ka && x == 1.0) return b;
+        if (kb && y == 1.0) return a;
+        if (ka && x == -1.0) return unary(ExprNode::Neg, b);
+        if (kb && y == -1.0) return unary(ExprNode::Neg, a);
+        break;
+    case ExprNode::Div:
+        if (kb && y == 1.0) return a;
+        if (kb && y == -1.0) return unary(ExprNode::Neg, a);
+        if (kb && y != 0.0 && std::isfinite(y)) {
+            // Dividing by a power of two is an exact multiply
+            int exponent;
+            if (std::fabs(std::frexp(y, &exponent)) == 0.5 && std::isfinite(1.0 / y)) {
+                return binary(ExprNode::Mul, a, constant(1.0 / y));
+            }
+        }
+        break;
+    case ExprNode::Pow:
+        if (ka && x == 1.0) return constant(1.0);
+        if (!kb) break;
+        if (y == 0.0) return constant(1.0);
+        if (y == 1.0) return a;
+        if (y == 0.5) return call(ExprNode::Sqrt, a, -1, -1);
+        if (y == -1.0) return binary(ExprNode::Div, constant(1.0), a);
+        // Squaring a leaf costs one multiply and no extra text
+        if (y == 2.0 && m_out.nodes[a].op == ExprNode::Variable) return make(ExprNode::Mul, a, a);
+        break;
+    case ExprNode::Lt: case ExprNode::Le: case ExprNode::Gt:
+    case ExprNode::Ge: case ExprNode::Eq: case ExprNode::Ne: {
+        const std::int32_t known = compareTime(op, a, b);
+        if (known >= 0) return known;
+        break;
+    }
+    case ExprNode::And:
+        if ((ka && x == 0.0) || (kb && y == 0.0)) return constant(0.0);
+        if (ka && isBoolean(b)) return b;
+        if (kb && isBoolean(a)) return a;
+        break;
+    case ExprNode::Or:
+        if ((ka && x != 0.0) || (kb && y != 0.0)) return constant(1.0);
+        if (ka && isBoolean(b)) return b;
+        if (kb && isBoolean(a)) return a;
+        break;
+    default:
+        break;
+    }
+    return make(op, a, b);
+}
+
+// t against a constant, knowing 0 <= t <= duration. Returns a constant node,
+// or -1 when the comparison can go either way.
+std::int32_t ExprSimplifier::compareTime(ExprNode::Op op, std::int32_t a, std::int32_t b) {
+    double k;
+    if (isConst(a, k) && isTime(b)) {
+        // K < t is t > K
+        switch (op) {
+        case ExprNode::Lt: op = ExprNode::Gt; break;
+        case ExprNode::Le: op = ExprNode::Ge; break;
+        case ExprNode::Gt: op = ExprNode::Lt; break;
+        case ExprNode::Ge: op = ExprNode::Le; break;
+        default: break;
+        }
+    } else if (!(isTime(a) && isConst(b, k))) {
+        return -1;
+    }
+
+    const double end = m_duration;
+    int result = -1;
+    switch (op) {
+    case ExprNode::Lt: result = k > end ? 1 : (k <= 0.0 ? 0 : -1); break;
+    case ExprNode::Le: result = k >= end ? 1 : (k < 0.0 ? 0 : -1); break;
+    case ExprNode::Gt: result = k >= end ? 0 : (k < 0.0 ? 1 : -1); break;
+    case ExprNode::Ge: result = k > end ? 0 : (k <= 0.0 ? 1 : -1); break;
+    case ExprNode::Eq: result = (k < 0.0 || k > end) ? 0 : -1; break;
+    case ExprNode::Ne: result = (k < 0.0 || k > end) ? 1 : -1; break;
+    default: break;
+    }
+    return result < 0 ? -1 : constant(result);
+}
+
+std::int32_t ExprSimplifier::select(std::int32_t a, std::int32_t b, std::int32_t c) {
+    double x, y;
+    if (isConst(a, x)) return x != 0.0 ? b : c;     // Dead branch
+    if (b == c) return b;
+    if (isConst(b, x) && isConst(c, y) && x == y) return b;
+    if (isBoolean(a) && hasValue(b, 1.0) && hasValue(c, 0.0)) return a;
+    return make(ExprNode::Select, a, b, c);
+}
+
+std::int32_t ExprSimplifier::call(ExprNode::Func func, std::int32_t a, std::int32_t b, std::int32_t c) {
+    const int arity = ExprNode::arity(func);
+    double args[3] = { 0.0, 0.0, 0.0 };
+    const std::int32_t nodes[3] = { a, b, c };
+    bool folded = !ExprNode::isStateful(func) && func != ExprNode::Randv && func != ExprNode::Randsv;
+    for (int i = 0; i < arity && folded; ++i) folded = isConst(nodes[i], args[i]);
+    if (folded) {
+        const double r = ExprVM::evaluateFunction(func, args[0], args[1], args[2]);
+        if (std::isfinite(r)) return constant(r);
+    }
+
+    if (func == ExprNode::Min || func == ExprNode::Max) {
+        if (a == b) return a;
+        // min(1, t / 0): an envelope stage of zero length is already complete
+        double k;
+        if (func == ExprNode::Min && isConst(a, k) && isTimeOverZero(b)) return a;
+        if (func == ExprNode::Min && isConst(b, k) && isTimeOverZero(a)) return b;
+    }
+    return make(ExprNode::Call, a, b, c, func);
+}
+
+void ExprSimplifier::run() {
+    m_out.clear();
+    if (!m_tree.isValid()) return;
+
+    const size_t count = m_tree.nodes.size();
+    std::vector<char> reachable(count, 0);
+    reachable[m_tree.root] = 1;
+    for (size_t i = count; i-- > 0;) {
+        if (!reachable[i]) continue;
+        const ExprNode &node = m_tree.nodes[i];
+        for (std::int32_t child : { node.a, node.b, node.c }) {
+            if (child >= 0) reachable[child] = 1;
+        }
+    }
+
+    std::vector<std::int32_t> map(count, -1);
+    m_out.nodes.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (!reachable[i]) continue;
+        const ExprNode &node = m_tree.nodes[i];
+        const std::int32_t a = node.a >= 0 ? map[node.a] : -1;
+        const std::int32_t b = node.b >= 0 ? map[node.b] : -1;
+        const std::int32_t c = node.c >= 0 ? map[node.c] : -1;
+        switch (node.op) {
+        case ExprNode::Const:    map[i] = constant(node.value); break;
+        case ExprNode::Variable: map[i] = m_out.add(node); break;
+        case ExprNode::Neg:
+        case ExprNode::Not:      map[i] = unary((ExprNode::Op)node.op, a); break;
+        case ExprNode::Select:   map[i] = select(a, b, c); break;
+        case ExprNode::Call:     map[i] = call((ExprNode::Func)node.index, a, b, c); break;
+        default:                 map[i] = binary((ExprNode::Op)node.op, a, b); break;
+        }
+    }
+
+    m_out.root = map[m_tree.root];
+    for (const ExprBinding &binding : m_tree.bindings) {
+        if (map[binding.node] >= 0) m_out.bindings.push_back({ binding.name, map[binding.node] });
+    }
+}
+
+void simplifyTree(const ExprTree &tree, ExprTree &out, const ExprOptimizeOptions &options) {
+    ExprSimplifier simplifier(tree, out, options);
+    simplifier.run();
+}
+
+// --- COMMON SUBTREES ---
+namespace {
+
+// Children are already canonical when a node is looked up, so comparing the
+// node itself compares the whole subtree
+struct NodeKey {
+    std::uint8_t op;
+    std::uint8_t index;
+    std::int32_t a, b, c;
+    std::uint64_t value;
+
+    bool operator==(const NodeKey &other) const {
+        return op == other.op && index == other.index && a == other.a && b == other.b
+            && c == other.c && value == other.value;
+    }
+};
+
+struct NodeKeyHash {
+    std::size_t operator()(const NodeKey &key) const {
+        std::uint64_t h = key.value ^ (std::uint64_t(key.op) << 56) ^ (std::uint64_t(key.index) << 48);
+        h = (h ^ std::uint32_t(key.a)) * 0x9E3779B97F4A7C15ull;
+        h = (h ^ std::uint32_t(key.b)) * 0x9E3779B97F4A7C15ull;
+        h = (h ^ std::uint32_t(key.c)) * 0x9E3779B97F4A7C15ull;
+        return std::size_t(h ^ (h >> 32));
+    }
+};
+
+} // namespace
+
+void hoistCommonSubtrees(const ExprTree &tree, ExprTree &out) {
+    out.clear();
+    if (!tree.isValid()) return;
+
+    // Reachable at all, and reachable without passing through a ternary branch.
+    // A var value runs on every sample wherever it is read.
+    const size_t count = tree.nodes.size();
+    std::vector<char> reachable(count, 0), always(count, 0);
+    reachable[tree.root] = always[tree.root] = 1;
+    for (const ExprBinding &binding : tree.bindings) always[binding.node] = 1;
+    for (size_t i = count; i-- > 0;) {
+        if (!reachable[i]) continue;
+        const ExprNode &node = tree.nodes[i];
+        const std::int32_t children[3] = { node.a, node.b, node.c };
+        for (int k = 0; k < 3; ++k) {
+            if (children[k] < 0) continue;
+            reachable[children[k]] = 1;
+            if (always[i] && (node.op != ExprNode::Select || k == 0)) always[children[k]] = 1;
+        }
+    }
+
+    std::unordered_map<NodeKey, std::int32_t, NodeKeyHash> seen;
+    seen.reserve(count);
+    std::vector<std::int32_t> map(count, -1);
+    out.nodes.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (!reachable[i]) continue;
+        ExprNode node = tree.nodes[i];
+        if (node.a >= 0) node.a = map[node.a];
+        if (node.b >= 0) node.b = map[node.b];
+        if (node.c >= 0) node.c = map[node.c];
+        if (node.op == ExprNode::Call && node.index == ExprNode::Integrate && !always[i]) {
+            map[i] = out.add(node);
+            continue;
+        }
+        NodeKey key = { node.op, node.index, node.a, node.b, node.c, 0 };
+        std::memcpy(&key.value, &node.value, sizeof key.value);
+        auto found = seen.find(key);
+        if (found != seen.end()) {
+            map[i] = found->second;
+        } else {
+            map[i] = out.add(node);
+            seen.emplace(key, map[i]);
+        }
+    }
+    out.root = map[tree.root];
+
+    std::vector<char> named(out.nodes.size(), 0);
+    for (const ExprBinding &binding : tree.bindings) {
+        if (map[binding.node] < 0 || named[map[binding.node]]) continue;
+        named[map[binding.node]] = 1;
+        out.bindings.push_back({ binding.name, map[binding.node] });
+    }
+
+    std::vector<int> uses(out.nodes.size(), 0);
+    for (const ExprNode &node : out.nodes) {
+        for (std::int32_t child : { node.a, node.b, node.c }) {
+            if (child >= 0) ++uses[child];
+        }
+    }
+    int next = 1;
+    for (size_t i = 0; i < out.nodes.size(); ++i) {
+        const ExprNode::Op op = (ExprNode::Op)out.nodes[i].op;
+        if (uses[i] < 2 || named[i] || op == ExprNode::Const || op == ExprNode::Variable) continue;
+        out.bindings.push_back({ "cse" + std::to_string(next++), (std::int32_t)i });
+    }
+}
+
+// --- SOURCE TO SOURCE ---
+std::string optimizeSource(const std::string &source, const ExprOptimizeOptions &options) {
+    ExprTree tree;
+    if (!ExprTree::parse(source, tree)) return source;
+    ExprTree simplified;
+    simplifyTree(tree, simplified, options);
+    if (!options.hoistCommon) return simplified.toSource();
+    ExprTree shared;
+    hoistCommonSubtrees(simplified, shared);
+    return shared.toSource();
+}
@@ -0,0 +1,46 @@
+#ifndef EXPROPTIMIZE_H
+#define EXPROPTIMIZE_H
+
+#include <string>
+#include "exprtree.h"
+
+// ==============================================================================
+// EXPRESSION OPTIMISATION
+// ==============================================================================
+// Tree-to-tree rewrites run on every generated string before it is shown or
+// shipped. The generators paste raw control values into templates, so their
+// output is full of `1.0000 * x`, `exp(-t * 0)` and branches for time windows
+// the sound never reaches; LMMS pays for all of it on every sample.
+//
+// Rewrites never change what the expression computes for t within the sound,
+// apart from the usual floating-point caveats of algebra on finite values (x * 0
+// is 0 even if x could be infinite). Calls whose result LMMS computes
+// differently from us (randv, randsv) and stateful calls are never folded.
+
+struct ExprOptimizeOptions {
+    // Length of the sound in seconds; ternary branches for later times are
+    // dropped (allowing for the rounding of printed times). 0 when the sound
+    // is open-ended, so only t < 0 is known to be dead.
+    double duration = 0.0;
+    // Share repeated subtrees as `var cseN := ...;` (hoistCommonSubtrees).
+    // Nightly only: Legacy Xpressive has no var statement.
+    bool hoistCommon = false;
+};
+
+// Constant folding, identity and zero elimination, strength reduction and
+// dead-branch removal. out may not be tree. Non-recursive.
+void simplifyTree(const ExprTree &tree, ExprTree &out, const ExprOptimizeOptions &options = ExprOptimizeOptions());
+
+// Hash-consing: structurally equal subtrees become one node, and any shared
+// node that isn't a plain input or number gets a cseN binding so toSource()
+// prints it once as a var. Text pasted in twice by a generator then costs LMMS
+// one evaluation. An integrate() under a ternary branch keeps its own node,
+// since each call site only accumulates while its branch is taken. out may not
+// be tree. Non-recursive.
+void hoistCommonSubtrees(const ExprTree &tree, ExprTree &out);
+
+// Parse, simplify (and hoist, if asked) and print. Returns the source unchanged when it doesn't parse,
+// so anything the parser can't model still goes out as the generator wrote it.
+std::string optimizeSource(const std::string &source, const ExprOptimizeOptions &options = ExprOptimizeOptions());
+
+#endif // EXPROPTIMIZE_H
@@ -0,0 +1,861 @@
+#include "exprtree.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+
+// --- NODE METADATA ---
+int ExprNode::arity(Func func) {
+    if (func >= Clamp) return 3;
+    if (func >= Min) return 2;
+    return 1;
+}
+
+const char *ExprNode::funcName(Func func) {
+    static const char *const names[FuncCount] = {
+        "sin", "cos", "tan", "asin", "acos", "atan", "sinh", "cosh", "tanh",
+        "exp", "log", "log10", "log2", "sqrt", "abs", "floor", "ceil", "round", "trunc", "sgn",
+        "sinew", "saww", "squarew", "trianglew", "randv", "semitone",
+        "integrate", "last",
+        "min", "max", "atan2", "randsv",
+        "clamp"
+    };
+    return func < FuncCount ? names[func] : "?";
+}
+
+const char *ExprNode::inputName(Input input) {
+    static const char *const names[InputCount] = {
+        "t", "f", "srate", "tempo", "v", "key", "rel", "trel", "A1", "A2", "A3"
+    };
+    return input < InputCount ? names[input] : "?";
+}
+
+// --- TREE ---
+std::int32_t ExprTree::add(const ExprNode &node) {
+    nodes.push_back(node);
+    return (std::int32_t)nodes.size() - 1;
+}
+
+std::int32_t ExprTree::addConst(double value) {
+    ExprNode node;
+    node.op = ExprNode::Const;
+    node.value = value;
+    return add(node);
+}
+
+void ExprTree::clear() {
+    nodes.clear();
+    bindings.clear();
+    root = -1;
+}
+
+// --- NUMBERS ---
+// Xpressive text always uses '.', whatever LC_NUMERIC the application runs
+// under. QApplication adopts the user's locale on Unix and strtod / printf
+// follow it, so a de_DE desktop would otherwise read "0.5" as 0 and print 0,5.
+namespace {
+
+// strtod on a copy with '.' swapped for the locale's decimal point
+double strtodClassic(const char *first, const char *last) {
+    std::string text(first, last);
+    const char point = *std::localeconv()->decimal_point;
+    if (point != '.') std::replace(text.begin(), text.end(), '.', point);
+    return std::strtod(text.c_str(), nullptr);
+}
+
+// first..last is a whole decimal literal: digits, '.', exponent
+double parseNumber(const char *first, const char *last) {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    double value = 0.0;
+    const std::from_chars_result result = std::from_chars(first, last, value);
+    if (result.ec == std::errc() && result.ptr == last) return value;
+#endif
+    // No floating-point from_chars, or out of range (strtod gives inf or 0)
+    return strtodClassic(first, last);
+}
+
+// Shortest text that reads back as exactly the same double, so the values
+// generators write (0.25, 8000, 0.841471) come back out as written
+void appendNumber(std::string &out, double value) {
+    char buffer[32];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof buffer, value);
+    out.append(buffer, result.ptr);
+#else
+    for (int digits = 15; digits <= 17; ++digits) {
+        std::snprintf(buffer, sizeof buffer, "%.*g", digits, value);
+        if (std::strtod(buffer, nullptr) == value) break;   // Same locale both ways
+    }
+    const char point = *std::localeconv()->decimal_point;
+    if (point != '.') std::replace(buffer, buffer + std::strlen(buffer), point, '.');
+    out += buffer;
+#endif
+}
+
+} // namespace
+
+// --- PARSER ---
+// Operator precedence with explicit stacks instead of recursive descent, so a
+// ternary tree thousands of levels deep costs heap, not call stack.
+namespace {
+
+struct Token {
+    enum Kind { End, Number, Name, Symbol };
+    Kind kind = End;
+    std::size_t pos = 0;
+    std::size_t length = 0;
+    double number = 0.0;
+};
+
+// Binding strengths; higher binds tighter
+enum Precedence {
+    PrecTernary = 1, PrecOr, PrecAnd, PrecCompare, PrecAdd, PrecMul, PrecUnary, PrecPow
+};
+
+struct StackEntry {
+    enum Kind { Binary, Unary, Paren, Call, Question, Colon, Binding };
+    Kind kind = Binary;
+    std::uint8_t op = 0;        // ExprNode::Op, or ExprNode::Func for calls
+    int precedence = 0;
+    int args = 0;               // Calls: arguments completed so far
+    std::size_t pos = 0;
+    std::string name;           // Calls: for error messages. Bindings: the var
+};
+
+// ExprNode::Op for a binary operator symbol, or -1
+static int binaryOperator(std::string_view sym, int &precedence) {
+    const char second = sym.size() > 1 ? sym[1] : '\0';
+    switch (sym[0]) {
+    case '+': precedence = PrecAdd; return ExprNode::Add;
+    case '-': precedence = PrecAdd; return ExprNode::Sub;
+    case '*': precedence = PrecMul; return ExprNode::Mul;
+    case '/': precedence = PrecMul; return ExprNode::Div;
+    case '%': precedence = PrecMul; return ExprNode::Mod;
+    case '^': precedence = PrecPow; return ExprNode::Pow;
+    case '<': precedence = PrecCompare; return second == '=' ? ExprNode::Le : (second == '>' ? ExprNode::Ne : ExprNode::Lt);
+    case '>': precedence = PrecCompare; return second == '=' ? ExprNode::Ge : ExprNode::Gt;
+    case '=': precedence = PrecCompare; return ExprNode::Eq;
+    case '!': precedence = PrecCompare; return second == '=' ? ExprNode::Ne : -1;
+    case '&': precedence = PrecAnd; return ExprNode::And;
+    case '|': precedence = PrecOr; return ExprNode::Or;
+    default: return -1;
+    }
+}
+
+// Pseudo-functions that are really operators in the tree
+enum { FuncMod = ExprNode::FuncCount, FuncPow };
+
+class Parser {
+public:
+    Parser(const std::string &source, ExprTree &tree) : m_src(source), m_tree(tree) {}
+
+    bool run(ExprParseError *error);
+
+private:
+    Token lex();
+    Token next();
+    Token peek();
+    Token peekSecond();
+    std::string text(const Token &tok) const { return m_src.substr(tok.pos, tok.length); }
+    bool isSymbol(const Token &tok, const char *symbol) const;
+
+    std::int32_t parseExpression();
+    bool reduce();
+    bool reduceWhile(int precedence, bool rightAssoc);
+    bool finishCall(const StackEntry &call);
+    bool reservedName(const std::string &name) const;
+    bool fail(std::size_t pos, const std::string &message);
+    std::int32_t failValue(std::size_t pos, const std::string &message) { fail(pos, message); return -1; }
+
+    const std::string &m_src;
+    ExprTree &m_tree;
+    std::size_t m_pos = 0;
+    Token m_lookahead;              // peek() result, so no token is lexed twice
+    std::size_t m_lookaheadEnd = 0;
+    bool m_hasLookahead = false;
+    std::vector<std::int32_t> m_operands;
+    std::vector<StackEntry> m_operators;
+    std::unordered_map<std::string, std::int32_t> m_names;   // var name -> node
+    std::int32_t m_literal = -1;    // Node of the most recent number token
+    ExprParseError m_error;
+    bool m_failed = false;
+};
+
+const std::unordered_map<std::string, int> &functionTable() {
+    static const std::unordered_map<std::string, int> table = [] {
+        std::unordered_map<std::string, int> map;
+        for (int f = 0; f < ExprNode::FuncCount; ++f) map[ExprNode::funcName((ExprNode::Func)f)] = f;
+        map["mod"] = FuncMod;
+        map["pow"] = FuncPow;
+        map["ln"] = ExprNode::Log;
+        return map;
+    }();
+    return table;
+}
+
+const std::unordered_map<std::string, int> &inputTable() {
+    static const std::unordered_map<std::string, int> table = [] {
+        std::unordered_map<std::string, int> map;
+        for (int i = 0; i < ExprNode::InputCount; ++i) map[ExprNode::inputName((ExprNode::Input)i)] = i;
+        return map;
+    }();
+    return table;
+}
+
+bool Parser::fail(std::size_t pos, const std::string &message) {
+    if (!m_failed) {
+        m_failed = true;
+        m_error.position = pos;
+        m_error.message = message;
+    }
+    return false;
+}
+
+Token Parser::lex() {
+    // Whitespace and comments
+    for (;;) {
+        while (m_pos < m_src.size() && std::isspace((unsigned char)m_src[m_pos])) ++m_pos;
+        if (m_pos >= m_src.size()) break;
+        const char following = (m_pos + 1 < m_src.size()) ? m_src[m_pos + 1] : '\0';
+        if (m_src[m_pos] == '#' || (m_src[m_pos] == '/' && following == '/')) {
+            while (m_pos < m_src.size() && m_src[m_pos] != '\n') ++m_pos;
+        } else if (m_src[m_pos] == '/' && following == '*') {
+            const std::size_t close = m_src.find("*/", m_pos + 2);
+            m_pos = (close == std::string::npos) ? m_src.size() : close + 2;
+        } else {
+            break;
+        }
+    }
+
+    Token tok;
+    tok.pos = m_pos;
+    if (m_pos >= m_src.size()) return tok;
+
+    const char c = m_src[m_pos];
+    if (std::isdigit((unsigned char)c) || (c == '.' && m_pos + 1 < m_src.size() && std::isdigit((unsigned char)m_src[m_pos + 1]))) {
+        // digits [. digits] [e [+-] digits]
+        const std::size_t size = m_src.size();
+        std::size_t end = m_pos;
+        while (end < size && std::isdigit((unsigned char)m_src[end])) ++end;
+        if (end < size && m_src[end] == '.') {
+            ++end;
+            while (end < size && std::isdigit((unsigned char)m_src[end])) ++end;
+        }
+        if (end < size && (m_src[end] == 'e' || m_src[end] == 'E')) {
+            std::size_t exponent = end + 1;
+            if (exponent < size && (m_src[exponent] == '+' || m_src[exponent] == '-')) ++exponent;
+            if (exponent < size && std::isdigit((unsigned char)m_src[exponent])) {
+                end = exponent;
+                while (end < size && std::isdigit((unsigned char)m_src[end])) ++end;
+            }
+        }
+        tok.kind = Token::Number;
+        tok.number = parseNumber(m_src.data() + m_pos, m_src.data() + end);
+        m_pos = end;
+    } else if (std::isalpha((unsigned char)c) || c == '_') {
+        tok.kind = Token::Name;
+        while (m_pos < m_src.size() && (std::isalnum((unsigned char)m_src[m_pos]) || m_src[m_pos] == '_')) ++m_pos;
+    } else {
+        // := == != <> <= >= && ||
+        tok.kind = Token::Symbol;
+        m_pos += 1;
+        const char d = (m_pos < m_src.size()) ? m_src[m_pos] : '\0';
+        if ((d == '=' && (c == ':' || c == '=' || c == '!' || c == '<' || c == '>'))
+            || (c == '<' && d == '>') || (c == '&' && d == '&') || (c == '|' && d == '|')) {
+            ++m_pos;
+        }
+    }
+    tok.length = m_pos - tok.pos;
+    return tok;
+}
+
+Token Parser::next() {
+    if (!m_hasLookahead) return lex();
+    m_hasLookahead = false;
+    m_pos = m_lookaheadEnd;
+    return m_lookahead;
+}
+
+Token Parser::peek() {
+    if (!m_hasLookahead) {
+        const std::size_t saved = m_pos;
+        m_lookahead = lex();
+        m_lookaheadEnd = m_pos;
+        m_pos = saved;
+        m_hasLookahead = true;
+    }
+    return m_lookahead;
+}
+
+// The token after peek(), without consuming either
+Token Parser::peekSecond() {
+    peek();
+    const std::size_t saved = m_pos;
+    m_pos = m_lookaheadEnd;
+    const Token tok = lex();
+    m_pos = saved;
+    return tok;
+}
+
+bool Parser::isSymbol(const Token &tok, const char *symbol) const {
+    return tok.kind == Token::Symbol && std::string_view(m_src.data() + tok.pos, tok.length) == symbol;
+}
+
+bool Parser::reservedName(const std::string &name) const {
+    return functionTable().count(name) || inputTable().count(name);
+}
+
+// Pops one operator and its operands into a node
+bool Parser::reduce() {
+    StackEntry top = m_operators.back();
+    m_operators.pop_back();
+
+    ExprNode node;
+    if (top.kind == StackEntry::Unary) {
+        if (m_operands.empty()) return fail(top.pos, "missing operand");
+        const std::int32_t a = m_operands.back();
+        m_operands.pop_back();
+        // Negative literals stay literals (but never negate a shared binding)
+        if (top.op == ExprNode::Neg && a == m_literal && a == (std::int32_t)m_tree.nodes.size() - 1) {
+            m_tree.nodes[a].value = -m_tree.nodes[a].value;
+            m_operands.push_back(a);
+            return true;
+        }
+        node.op = (ExprNode::Op)top.op;
+        node.a = a;
+    } else if (top.kind == StackEntry::Binary) {
+        if (m_operands.size() < 2) return fail(top.pos, "missing operand");
+        node.op = (ExprNode::Op)top.op;
+        node.b = m_operands.back();
+        m_operands.pop_back();
+        node.a = m_operands.back();
+        m_operands.pop_back();
+    } else if (top.kind == StackEntry::Colon) {
+        if (m_operands.size() < 3) return fail(top.pos, "missing operand");
+        node.op = ExprNode::Select;
+        node.c = m_operands.back();
+        m_operands.pop_back();
+        node.b = m_operands.back();
+        m_operands.pop_back();
+        node.a = m_operands.back();
+        m_operands.pop_back();
+    } else if (top.kind == StackEntry::Question) {
+        return fail(top.pos, "'?' without ':'");
+    } else if (top.kind == StackEntry::Binding) {
+        return fail(top.pos, "expected ';' after 'var " + top.name + "'");
+    } else {
+        return fail(top.pos, top.kind == StackEntry::Call ? "unclosed call to " + top.name : "unclosed '('");
+    }
+    m_operands.push_back(m_tree.add(node));
+    return true;
+}
+
+// Reduces operators that bind at least as tightly as an incoming one
+bool Parser::reduceWhile(int precedence, bool rightAssoc) {
+    while (!m_operators.empty()) {
+        const StackEntry &top = m_operators.back();
+        if (top.kind != StackEntry::Binary && top.kind != StackEntry::Unary && top.kind != StackEntry::Colon) break;
+        if (top.precedence < precedence || (top.precedence == precedence && rightAssoc)) break;
+        if (!reduce()) return false;
+    }
+    return true;
+}
+
+bool Parser::finishCall(const StackEntry &call) {
+    const int func = call.op;
+    const int count = call.args;
+    if ((int)m_operands.size() < count) return fail(call.pos, "missing operand");
+
+    const bool variadic = (func == ExprNode::Min || func == ExprNode::Max);
+    const int wanted = (func == FuncMod || func == FuncPow) ? 2 : ExprNode::arity((ExprNode::Func)func);
+    if (variadic ? count < 2 : count != wanted) {
+        return fail(call.pos, call.name + "() takes " + std::to_string(wanted) + " argument" + (wanted == 1 ? "" : "s"));
+    }
+
+    const std::int32_t *args = m_operands.data() + m_operands.size() - count;
+    ExprNode node;
+    if (func == FuncMod || func == FuncPow) {
+        node.op = (func == FuncMod) ? ExprNode::Mod : ExprNode::Pow;
+        node.a = args[0];
+        node.b = args[1];
+    } else {
+        node.op = ExprNode::Call;
+        node.index = (std::uint8_t)func;
+        node.a = args[0];
+        node.b = count > 1 ? args[1] : -1;
+        node.c = count > 2 ? args[2] : -1;
+    }
+    std::int32_t result = m_tree.add(node);
+
+    // min(a, b, c, ...) folds left into binary calls
+    for (int i = 2; variadic && i < count; ++i) {
+        node.a = result;
+        node.b = args[i];
+        result = m_tree.add(node);
+    }
+
+    m_operands.resize(m_operands.size() - count);
+    m_operands.push_back(result);
+    return true;
+}
+
+// Parses up to the next ';' (or the end) at bracket depth zero. A bracket may
+// open with `var name := value;` statements, as the scope generators write
+// `(var s := ...; tree)`; the name stays bound after the bracket closes.
+std::int32_t Parser::parseExpression() {
+    m_operands.clear();
+    m_operators.clear();
+    bool expectOperand = true;
+
+    for (;;) {
+        const Token tok = peek();
+        const std::string_view sym = (tok.kind == Token::Symbol) ? std::string_view(m_src).substr(tok.pos, tok.length) : std::string_view();
+
+        if (expectOperand) {
+            next();
+            if (tok.kind == Token::Number) {
+                m_literal = m_tree.addConst(tok.number);
+                m_operands.push_back(m_literal);
+                expectOperand = false;
+            } else if (tok.kind == Token::Name) {
+                const std::string name = text(tok);
+                if (name == "var" && !m_operators.empty() && m_operators.back().kind == StackEntry::Paren) {
+                    const Token bound = next();
+                    if (bound.kind != Token::Name) return failValue(bound.pos, "expected a name after 'var'");
+                    const std::string bindName = text(bound);
+                    if (reservedName(bindName)) return failValue(bound.pos, "'" + bindName + "' is a reserved name");
+                    const Token assign = next();
+                    if (!isSymbol(assign, ":=")) return failValue(assign.pos, "expected ':=' after 'var " + bindName + "'");
+                    m_operators.push_back({ StackEntry::Binding, 0, 0, 0, tok.pos, bindName });
+                    continue;
+                }
+                if (name == "not") {
+                    m_operators.push_back({ StackEntry::Unary, ExprNode::Not, PrecUnary, 0, tok.pos, {} });
+                    continue;
+                }
+                if (isSymbol(peek(), "(")) {
+                    const auto func = functionTable().find(name);
+                    if (func == functionTable().end()) return failValue(tok.pos, "unknown function '" + name + "'");
+                    next();
+                    StackEntry call { StackEntry::Call, (std::uint8_t)func->second, 0, 0, tok.pos, name };
+                    if (isSymbol(peek(), ")")) {
+                        return failValue(tok.pos, name + "() needs arguments");
+                    }
+                    m_operators.push_back(call);
+                    continue;
+                }
+
+                std::int32_t node = -1;
+                const auto input = inputTable().find(name);
+                const auto bound = m_names.find(name);
+                if (bound != m_names.end()) {
+                    node = bound->second;
+                } else if (input != inputTable().end()) {
+                    ExprNode in;
+                    in.op = ExprNode::Variable;
+                    in.index = (std::uint8_t)input->second;
+                    node = m_tree.add(in);
+                } else if (name == "pi") {
+                    node = m_tree.addConst(3.14159265358979323846);
+                } else if (name == "true" || name == "false") {
+                    node = m_tree.addConst(name == "true" ? 1.0 : 0.0);
+                } else {
+                    return failValue(tok.pos, "unknown variable '" + name + "'");
+                }
+                m_operands.push_back(node);
+                m_literal = -1;
+                expectOperand = false;
+            } else if (sym == "(") {
+                m_operators.push_back({ StackEntry::Paren, 0, 0, 0, tok.pos, {} });
+            } else if (sym == "-" || sym == "!") {
+                m_operators.push_back({ StackEntry::Unary, (std::uint8_t)(sym == "-" ? ExprNode::Neg : ExprNode::Not),
+                                        PrecUnary, 0, tok.pos, {} });
+            } else if (sym == "+") {
+                // Unary plus is a no-op
+            } else {
+                return failValue(tok.pos, tok.kind == Token::End ? "unexpected end of expression" : "expected a value before '" + std::string(sym) + "'");
+            }
+            continue;
+        }
+
+        // Expecting an operator
+        if (tok.kind == Token::End) break;
+        if (sym == ";") {
+            // Ends a bracketed var statement, or else the whole expression
+            std::size_t open = m_operators.size();
+            while (open > 0 && m_operators[open - 1].kind != StackEntry::Paren
+                   && m_operators[open - 1].kind != StackEntry::Call && m_operators[open - 1].kind != StackEntry::Binding) --open;
+            if (open == 0 || m_operators[open - 1].kind != StackEntry::Binding) break;
+            next();
+            while (m_operators.size() > open) {
+                if (!reduce()) return -1;
+            }
+            if (m_operands.empty()) return failValue(tok.pos, "missing operand");
+            const std::int32_t value = m_operands.back();
+            m_operands.pop_back();
+            m_names[m_operators.back().name] = value;
+            m_tree.bindings.push_back({ m_operators.back().name, value });
+            m_operators.pop_back();
+            expectOperand = true;
+            continue;
+        }
+
+        int binary = -1;
+        int precedence = 0;
+        if (tok.kind == Token::Symbol) {
+            binary = binaryOperator(sym, precedence);
+        } else if (tok.kind == Token::Name) {
+            const std::string_view word(m_src.data() + tok.pos, tok.length);
+            if (word == "and") {
+                binary = ExprNode::And;
+                precedence = PrecAnd;
+            } else if (word == "or") {
+                binary = ExprNode::Or;
+                precedence = PrecOr;
+            }
+        }
+
+        next();
+        if (binary >= 0) {
+            const bool rightAssoc = (binary == ExprNode::Pow);
+            if (!reduceWhile(precedence, rightAssoc)) return -1;
+            m_operators.push_back({ StackEntry::Binary, (std::uint8_t)binary, precedence, 0, tok.pos, {} });
+            expectOperand = true;
+        } else if (sym == "?") {
+            if (!reduceWhile(PrecTernary, true)) return -1;
+            m_operators.push_back({ StackEntry::Question, 0, PrecTernary, 0, tok.pos, {} });
+            expectOperand = true;
+        } else if (sym == ":") {
+            while (!m_operators.empty() && m_operators.back().kind != StackEntry::Question) {
+                const StackEntry::Kind kind = m_operators.back().kind;
+                if (kind == StackEntry::Paren || kind == StackEntry::Call || kind == StackEntry::Binding) break;
+                if (!reduce()) return -1;
+            }
+            if (m_operators.empty() || m_operators.back().kind != StackEntry::Question) {
+                return failValue(tok.pos, "':' without '?'");
+            }
+            m_operators.back().kind = StackEntry::Colon;
+            expectOperand = true;
+        } else if (sym == ")" || sym == ",") {
+            while (!m_operators.empty() && m_operators.back().kind != StackEntry::Paren && m_operators.back().kind != StackEntry::Call) {
+                if (m_operators.back().kind == StackEntry::Binding) {
+                    return failValue(tok.pos, "expected ';' after 'var " + m_operators.back().name + "'");
+                }
+                if (!reduce()) return -1;
+            }
+            if (m_operators.empty()) return failValue(tok.pos, "unmatched '" + std::string(sym) + "'");
+
+            StackEntry &open = m_operators.back();
+            if (sym == ",") {
+                if (open.kind != StackEntry::Call) return failValue(tok.pos, "',' outside a function call");
+                ++open.args;
+                expectOperand = true;
+                continue;
+            }
+            const StackEntry closed = open;
+            m_operators.pop_back();
+            if (closed.kind == StackEntry::Call) {
+                StackEntry call = closed;
+                ++call.args;
+                if (!finishCall(call)) return -1;
+            }
+        } else {
+            return failValue(tok.pos, "unexpected '" + text(tok) + "'");
+        }
+    }
+
+    while (!m_operators.empty()) {
+        if (!reduce()) return -1;
+    }
+    if (m_operands.size() != 1) return failValue(m_pos, "malformed expression");
+    return m_operands.back();
+}
+
+bool Parser::run(ExprParseError *error) {
+    m_tree.clear();
+    m_tree.nodes.reserve(m_src.size() / 6 + 16);
+
+    std::int32_t result = -1;
+    while (!m_failed) {
+        Token tok = peek();
+        if (tok.kind == Token::End) break;
+        if (isSymbol(tok, ";")) {
+            next();
+            continue;
+        }
+
+        // var name := value;   name := value;
+        std::string bindName;
+        const bool declaration = (tok.kind == Token::Name && text(tok) == "var");
+        if (declaration) {
+            next();
+            const Token name = next();
+            if (name.kind != Token::Name) {
+                fail(name.pos, "expected a name after 'var'");
+                break;
+            }
+            bindName = text(name);
+            if (reservedName(bindName)) {
+                fail(name.pos, "'" + bindName + "' is a reserved name");
+                break;
+            }
+            const Token assign = next();
+            if (isSymbol(assign, ";") || assign.kind == Token::End) {
+                // var x;  starts at zero
+                result = m_tree.addConst(0.0);
+                m_names[bindName] = result;
+                m_tree.bindings.push_back({ bindName, result });
+                continue;
+            }
+            if (!isSymbol(assign, ":=")) {
+                fail(assign.pos, "expected ':=' after 'var " + bindName + "'");
+                break;
+            }
+        } else if (tok.kind == Token::Name && isSymbol(peekSecond(), ":=")) {
+            bindName = text(tok);
+            if (!m_names.count(bindName)) {
+                fail(tok.pos, "assignment to undeclared '" + bindName + "'");
+                break;
+            }
+            next();
+            next();
+        }
+
+        result = parseExpression();
+        if (result < 0) break;
+        if (!bindName.empty()) {
+            // A reassignment is a fresh binding; later reads see the new value
+            m_names[bindName] = result;
+            m_tree.bindings.push_back({ bindName, result });
+        }
+        if (isSymbol(peek(), ";")) next();
+    }
+
+    if (!m_failed && result < 0) fail(0, "empty expression");
+    if (m_failed) {
+        m_tree.clear();
+        if (error) *error = m_error;
+        return false;
+    }
+    m_tree.root = result;
+    return true;
+}
+
+} // namespace
+
+bool ExprTree::parse(const std::string &source, ExprTree &tree, ExprParseError *error) {
+    Parser parser(source, tree);
+    return parser.run(error);
+}
+
+// --- PRINTER ---
+namespace {
+
+constexpr int PrecAtom = PrecPow + 1;
+
+const char *binarySymbol(ExprNode::Op op) {
+    switch (op) {
+    case ExprNode::Add: return " + ";
+    case ExprNode::Sub: return " - ";
+    case ExprNode::Mul: return " * ";
+    case ExprNode::Div: return " / ";
+    case ExprNode::Pow: return " ^ ";
+    case ExprNode::Lt:  return " < ";
+    case ExprNode::Le:  return " <= ";
+    case ExprNode::Gt:  return " > ";
+    case ExprNode::Ge:  return " >= ";
+    case ExprNode::Eq:  return " == ";
+    case ExprNode::Ne:  return " != ";
+    case ExprNode::And: return " & ";
+    case ExprNode::Or:  return " | ";
+    default:            return " ? ";
+    }
+}
+
+int precedenceOf(const ExprNode &node) {
+    switch (node.op) {
+    case ExprNode::Const: return std::signbit(node.value) ? PrecUnary : PrecAtom;
+    case ExprNode::Neg: return PrecUnary;
+    case ExprNode::Add: case ExprNode::Sub: return PrecAdd;
+    case ExprNode::Mul: case ExprNode::Div: return PrecMul;
+    case ExprNode::Pow: return PrecPow;
+    case ExprNode::Lt: case ExprNode::Le: case ExprNode::Gt:
+    case ExprNode::Ge: case ExprNode::Eq: case ExprNode::Ne: return PrecCompare;
+    case ExprNode::And: return PrecAnd;
+    case ExprNode::Or: return PrecOr;
+    default: return PrecAtom;     // Variables, calls, and ternaries, which bring their own parentheses
+    }
+}
+
+// Writes one expression with an explicit work stack of text pieces and nodes,
+// so printing a tree is as flat as parsing it
+class Printer {
+public:
+    Printer(const ExprTree &tree, const std::vector<std::string> &names, std::string &out)
+        : m_tree(tree), m_names(names), m_out(out) {}
+
+    void write(std::int32_t node, bool definition);
+
+private:
+    struct Item {
+        std::int32_t node;      // -1 for a text piece
+        int required;           // Weakest precedence that needs no parentheses
+        const char *text;
+    };
+    void text(const char *piece) { m_work.push_back({ -1, 0, piece }); }
+    void child(std::int32_t node, int required) { m_work.push_back({ node, required, nullptr }); }
+    void expand(std::int32_t index, int required);
+
+    const ExprTree &m_tree;
+    const std::vector<std::string> &m_names;
+    std::string &m_out;
+    std::vector<Item> m_work;
+};
+
+void Printer::write(std::int32_t node, bool definition) {
+    // The definition of a named node is written out; everywhere else it's the name
+    if (definition) expand(node, 0); else child(node, 0);
+    while (!m_work.empty()) {
+        const Item item = m_work.back();
+        m_work.pop_back();
+        if (item.node < 0) {
+            m_out += item.text;
+        } else if (!m_names[item.node].empty()) {
+            m_out += m_names[item.node];
+        } else {
+            expand(item.node, item.required);
+        }
+    }
+}
+
+// Pushes pieces in reverse, so they pop in reading order
+void Printer::expand(std::int32_t index, int required) {
+    const ExprNode &node = m_tree.nodes[index];
+    switch (node.op) {
+    case ExprNode::Const:
+        if (precedenceOf(node) < required) {
+            m_out += '(';
+            appendNumber(m_out, node.value);
+            m_out += ')';
+        } else {
+            appendNumber(m_out, node.value);
+        }
+        return;
+    case ExprNode::Variable:
+        m_out += ExprNode::inputName((ExprNode::Input)node.index);
+        return;
+    default:
+        break;
+    }
+
+    const bool paren = precedenceOf(node) < required;
+    if (paren) text(")");
+    switch (node.op) {
+    case ExprNode::Neg:
+        child(node.a, PrecAtom);
+        text("-");
+        break;
+    case ExprNode::Not:
+        text(")");
+        child(node.a, 0);
+        text("not(");
+        break;
+    case ExprNode::Mod:
+        text(")");
+        child(node.b, 0);
+        text(", ");
+        child(node.a, 0);
+        text("mod(");
+        break;
+    case ExprNode::Select:
+        text(")");
+        child(node.c, PrecTernary);
+        text(" : ");
+        child(node.b, PrecTernary);
+        text(" ? ");
+        child(node.a, PrecTernary + 1);
+        text("(");
+        break;
+    case ExprNode::Call: {
+        text(")");
+        const std::int32_t args[3] = { node.a, node.b, node.c };
+        for (int i = ExprNode::arity((ExprNode::Func)node.index) - 1; i >= 0; --i) {
+            child(args[i], 0);
+            if (i > 0) text(", ");
+        }
+        text("(");
+        text(ExprNode::funcName((ExprNode::Func)node.index));
+        break;
+    }
+    default: {
+        // Left-associative operators chain on the left; comparisons and powers
+        // always get parentheses when nested, whatever the target parser thinks
+        const int prec = precedenceOf(node);
+        const bool chains = prec == PrecAdd || prec == PrecMul || prec == PrecAnd || prec == PrecOr;
+        child(node.b, prec + 1);
+        text(binarySymbol((ExprNode::Op)node.op));
+        child(node.a, chains ? prec : prec + 1);
+        break;
+    }
+    }
+    if (paren) text("(");
+}
+
+} // namespace
+
+std::string ExprTree::toSource() const {
+    if (!isValid()) return std::string();
+
+    // What the root reaches, and how often
+    std::vector<int> uses(nodes.size(), 0);
+    uses[root] = 1;
+    for (size_t i = nodes.size(); i-- > 0;) {
+        if (uses[i] == 0) continue;
+        for (std::int32_t child : { nodes[i].a, nodes[i].b, nodes[i].c }) {
+            if (child >= 0) ++uses[child];
+        }
+    }
+
+    // A binding read more than once stays a var, and so does one whose value
+    // has an integrate() or last() of its own: exprtk runs a var statement on
+    // every sample, and inlined into a ternary arm it would only run with the
+    // arm. The rest are inlined. Reassigned names get a suffix, since every
+    // var is declared up front.
+    std::vector<char> bound(nodes.size(), 0), keep(nodes.size(), 0), stateful(nodes.size(), 0);
+    for (const ExprBinding &binding : bindings) bound[binding.node] = 1;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const ExprNode &node = nodes[i];
+        stateful[i] = node.op == ExprNode::Call && ExprNode::isStateful((ExprNode::Func)node.index);
+        for (std::int32_t child : { node.a, node.b, node.c }) {
+            if (child >= 0 && stateful[child] && !keep[child]) stateful[i] = 1;
+        }
+        keep[i] = bound[i] && node.op != ExprNode::Variable && uses[i] > 0 && (uses[i] > 1 || stateful[i]);
+    }
+    std::vector<std::string> names(nodes.size());
+    std::unordered_map<std::string, int> taken;
+    std::vector<std::int32_t> declared;
+    for (const ExprBinding &binding : bindings) {
+        if (!keep[binding.node] || !names[binding.node].empty()) continue;
+        std::string name = binding.name;
+        if (const int count = taken[binding.name]++) name += "_" + std::to_string(count + 1);
+        names[binding.node] = name;
+        declared.push_back(binding.node);
+    }
+    std::sort(declared.begin(), declared.end());   // Children first
+
+    std::string out;
+    Printer printer(*this, names, out);
+    for (std::int32_t node : declared) {
+        out += "var " + names[node] + " := ";
+        printer.write(node, true);
+        out += ";\n";
+    }
+    printer.write(root, false);
+    return out;
+}
@@ -0,0 +1,109 @@
+#ifndef EXPRTREE_H
+#define EXPRTREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ==============================================================================
+// XPRESSIVE EXPRESSION TREES
+// ==============================================================================
+// Native model of the strings the tabs hand to LMMS's Xpressive instrument, so
+// the suite can play, draw and measure exactly what it ships instead of a
+// hand-written lambda that only approximates it.
+//
+// A tree is a flat arena of nodes. Children are always stored before their
+// parents, so every pass over a tree (evaluation, compilation, printing) is a
+// loop over node indices and never recurses; a multi-megabyte PCM expression
+// is just a long vector. `var` bindings don't get nodes of their own: a name
+// refers straight to the node of its value, so a binding used twice is a
+// shared subtree (and a stateful call inside it is still one call site).
+
+struct ExprNode {
+    enum Op : std::uint8_t {
+        Const,          // value
+        Variable,       // index = Input
+        Neg, Not,       // a
+        Add, Sub, Mul, Div, Mod, Pow,
+        Lt, Le, Gt, Ge, Eq, Ne, And, Or,    // a, b
+        Select,         // a ? b : c
+        Call            // index = Func, arguments in a, b, c
+    };
+
+    // Per-note inputs LMMS provides, by their Xpressive names
+    enum Input : std::uint8_t {
+        Time,           // t
+        Frequency,      // f
+        SampleRate,     // srate
+        Tempo,          // tempo
+        Velocity,       // v
+        Key,            // key
+        Release,        // rel
+        ReleaseTime,    // trel
+        Knob1, Knob2, Knob3,    // A1, A2, A3
+        InputCount
+    };
+
+    enum Func : std::uint8_t {
+        // One argument
+        Sin, Cos, Tan, Asin, Acos, Atan, Sinh, Cosh, Tanh,
+        Exp, Log, Log10, Log2, Sqrt, Abs, Floor, Ceil, Round, Trunc, Sgn,
+        Sinew, Saww, Squarew, Trianglew, Randv, Semitone,
+        Integrate,      // Running sum of arg / srate: state per call site
+        Last,           // Output arg samples ago: state per voice
+        // Two arguments
+        Min, Max, Atan2, Randsv,
+        // Three arguments
+        Clamp,          // clamp(lo, x, hi)
+        FuncCount
+    };
+
+    Op op = Const;
+    std::uint8_t index = 0;
+    std::int32_t a = -1;
+    std::int32_t b = -1;
+    std::int32_t c = -1;
+    double value = 0.0;
+
+    static int arity(Func func);
+    static const char *funcName(Func func);
+    static const char *inputName(Input input);
+    static bool isStateful(Func func) { return func == Integrate || func == Last; }
+};
+
+// A `var name := ...;` from the source, kept so printers can reuse the names
+struct ExprBinding {
+    std::string name;
+    std::int32_t node = -1;
+};
+
+struct ExprParseError {
+    std::size_t position = 0;   // Byte offset into the source
+    std::string message;
+};
+
+class ExprTree {
+public:
+    std::vector<ExprNode> nodes;
+    std::vector<ExprBinding> bindings;   // In declaration order
+    std::int32_t root = -1;
+
+    // Xpressive (exprtk) syntax: numbers, the Input names, pi, true/false,
+    // + - * / % ^, comparisons (= == != <>), & | and or not !, a ? b : c,
+    // the Func names plus mod() and pow(), `var x := ...;` and `x := ...;`
+    // statements, and // # /* */ comments. The last expression is the result.
+    // Never recurses, whatever the nesting depth of the source.
+    static bool parse(const std::string &source, ExprTree &tree, ExprParseError *error = nullptr);
+    // Back to Xpressive text with only the parentheses it needs. Bindings read
+    // more than once, or holding an integrate() or last() of their own, come
+    // out as `var` statements; the rest are inlined. Never recurses either.
+    std::string toSource() const;
+
+    std::int32_t add(const ExprNode &node);
+    std::int32_t addConst(double value);
+    bool isValid() const { return root >= 0 && root < (std::int32_t)nodes.size(); }
+    void clear();
+};
+
+#endif // EXPRTREE_H
@@ -0,0 +1,738 @@
+#include "exprvm.h"
+#include "exprjit.h"
+#include <algorithm>
+#include <cmath>
+
+// last(n) reads the output n samples ago, n truncated into [1, limit]
+static inline int lastOffset(double n, int limit) {
+    if (!(n >= 1.0)) return 1;      // Also catches NaN
+    return n >= limit ? limit : (int)n;
+}
+
+// --- COMPILER ---
+// Emits code for the reachable part of the tree. A `var` value, or any node
+// used more than once, is computed once, up front, and stays in its register
+// until its last reader; everything else is a single-use temporary freed as
+// soon as its parent has consumed it. Up front means outside every ternary, so
+// a `var p := integrate(...);` advances on every sample, as the statement does
+// in exprtk, even where p is only read in one arm. The walk uses an explicit
+// stack, so tree depth never reaches the call stack.
+class ExprCompiler {
+public:
+    ExprCompiler(const ExprTree &tree, ExprProgram &program) : m_tree(tree), m_program(program) {}
+    void run();
+
+private:
+    using Instr = ExprProgram::Instr;
+
+    struct Frame {
+        std::int32_t node;
+        int stage;
+        std::int32_t jump;      // Select: pending JumpNone / JumpAll
+        std::int32_t guard;     // Select: the enclosing arm's guard, restored after it
+    };
+
+    std::int32_t allocRegister();
+    void consume(std::int32_t node);
+    bool isImmediate(std::int32_t node) const;
+    int immediateSide(const ExprNode &node) const;   // 0 none, 1 = a, 2 = b
+    std::int32_t emit(const Instr &instr);
+    std::int32_t enterArm(std::int32_t cond, bool whenFalse);
+    void leaveArm(std::int32_t outer, std::int32_t cond);
+    void emitBinary(std::int32_t index, const ExprNode &node);
+    void emitCall(std::int32_t index, const ExprNode &node);
+    void emitTree(std::int32_t root);
+
+    const ExprTree &m_tree;
+    ExprProgram &m_program;
+    std::vector<int> m_uses;
+    std::vector<int> m_remaining;
+    std::vector<char> m_upFront;    // Shared, or a var value
+    std::vector<std::int32_t> m_reg;
+    std::vector<std::int32_t> m_freeRegisters;
+    std::vector<Frame> m_stack;
+    // Nodes whose code, once emitted, includes an integrate() of their own
+    std::vector<char> m_integrates;
+    // Lanes on which the ternary arm being emitted was selected; -1 outside any
+    std::int32_t m_guard = -1;
+};
+
+std::int32_t ExprCompiler::allocRegister() {
+    if (!m_freeRegisters.empty()) {
+        const std::int32_t reg = m_freeRegisters.back();
+        m_freeRegisters.pop_back();
+        return reg;
+    }
+    return m_program.m_registers++;
+}
+
+// A reader is done with node's value
+void ExprCompiler::consume(std::int32_t node) {
+    if (m_tree.nodes[node].op == ExprNode::Variable) return;
+    if (--m_remaining[node] == 0) m_freeRegisters.push_back(m_reg[node]);
+}
+
+// A mixed block runs both arms of a ternary, so an integrate() in either must
+// only advance on the lanes that selected it, as if the arm had run alone.
+// Sets m_guard for the arm to emit next, if it has an integrate() in it.
+std::int32_t ExprCompiler::enterArm(std::int32_t cond, bool whenFalse) {
+    const std::int32_t outer = m_guard;
+    if (!whenFalse && outer < 0) return m_guard = m_reg[cond];
+    const std::int32_t guard = allocRegister();
+    Instr instr;
+    instr.dst = guard;
+    if (whenFalse) {
+        instr.op = ExprProgram::Not;
+        instr.a = m_reg[cond];
+        emit(instr);
+        instr.a = guard;
+    } else {
+        instr.a = m_reg[cond];
+    }
+    if (outer >= 0) {
+        instr.op = ExprProgram::And;
+        instr.b = outer;
+        emit(instr);
+    }
+    return m_guard = guard;
+}
+
+void ExprCompiler::leaveArm(std::int32_t outer, std::int32_t cond) {
+    if (m_guard != outer && m_guard != m_reg[cond]) m_freeRegisters.push_back(m_guard);
+    m_guard = outer;
+}
+
+bool ExprCompiler::isImmediate(std::int32_t node) const {
+    return node >= 0 && m_tree.nodes[node].op == ExprNode::Const && m_uses[node] == 1;
+}
+
+int ExprCompiler::immediateSide(const ExprNode &node) const {
+    switch (node.op) {
+    case ExprNode::Add: case ExprNode::Sub: case ExprNode::Mul: case ExprNode::Div:
+    case ExprNode::Lt: case ExprNode::Le: case ExprNode::Gt: case ExprNode::Ge:
+    case ExprNode::Eq: case ExprNode::Ne:
+        if (isImmediate(node.b)) return 2;
+        return isImmediate(node.a) ? 1 : 0;
+    case ExprNode::Mod: case ExprNode::Pow:
+        return isImmediate(node.b) ? 2 : 0;
+    default:
+        return 0;
+    }
+}
+
+std::int32_t ExprCompiler::emit(const Instr &instr) {
+    m_program.m_code.push_back(instr);
+    return (std::int32_t)m_program.m_code.size() - 1;
+}
+
+void ExprCompiler::emitBinary(std::int32_t index, const ExprNode &node) {
+    using P = ExprProgram;
+    Instr instr;
+    const int side = immediateSide(node);
+
+    if (side == 0) {
+        static const P::Opcode plain[] = {
+            P::Add, P::Sub, P::Mul, P::Div, P::Mod, P::Pow,
+            P::Lt, P::Le, P::Gt, P::Ge, P::Eq, P::Ne, P::And, P::Or
+        };
+        instr.op = plain[node.op - ExprNode::Add];
+        instr.a = m_reg[node.a];
+        instr.b = m_reg[node.b];
+        consume(node.a);
+        consume(node.b);
+    } else if (side == 2) {
+        static const P::Opcode withK[] = {
+            P::AddK, P::SubK, P::MulK, P::DivK, P::ModK, P::PowK,
+            P::LtK, P::LeK, P::GtK, P::GeK, P::EqK, P::NeK
+        };
+        instr.op = withK[node.op - ExprNode::Add];
+        instr.a = m_reg[node.a];
+        instr.imm = m_tree.nodes[node.b].value;
+        consume(node.a);
+    } else {
+        // Constant on the left: commute, or use the reversed form
+        static const P::Opcode kFirst[] = {
+            P::AddK, P::KSub, P::MulK, P::KDiv, P::Mod, P::Pow,
+            P::GtK, P::GeK, P::LtK, P::LeK, P::EqK, P::NeK
+        };
+        instr.op = kFirst[node.op - ExprNode::Add];
+        instr.a = m_reg[node.b];
+        instr.imm = m_tree.nodes[node.a].value;
+        consume(node.b);
+    }
+    instr.dst = m_reg[index] = allocRegister();
+    emit(instr);
+}
+
+void ExprCompiler::emitCall(std::int32_t index, const ExprNode &node) {
+    Instr instr;
+    const ExprNode::Func func = (ExprNode::Func)node.index;
+    instr.func = node.index;
+    instr.a = m_reg[node.a];
+    if (node.b >= 0) instr.b = m_reg[node.b];
+    if (node.c >= 0) instr.c = m_reg[node.c];
+
+    if (func == ExprNode::Integrate) {
+        instr.op = ExprProgram::Integrate;
+        instr.b = m_guard;
+        instr.c = m_program.m_integrators++;
+    } else if (func == ExprNode::Last) {
+        instr.op = ExprProgram::Last;
+        m_program.m_usesHistory = true;
+        // A constant offset bounds the history and the block length; anything
+        // computed could be 1 at run time
+        const ExprNode &offset = m_tree.nodes[node.a];
+        int reach = ExprProgram::kMaxHistory;
+        int nearest = 1;
+        if (offset.op == ExprNode::Const) {
+            reach = nearest = lastOffset(offset.value, ExprProgram::kMaxHistory);
+        }
+        int length = 1;
+        while (length < reach) length <<= 1;
+        m_program.m_historyLength = std::max(m_program.m_historyLength, length);
+        m_program.m_blockLimit = std::min(m_program.m_blockLimit, nearest);
+    } else if (func == ExprNode::Clamp) {
+        instr.op = ExprProgram::Clamp;
+    } else {
+        instr.op = (ExprNode::arity(func) == 2) ? ExprProgram::Func2 : ExprProgram::Func1;
+    }
+
+    consume(node.a);
+    if (node.b >= 0) consume(node.b);
+    if (node.c >= 0) consume(node.c);
+    instr.dst = m_reg[index] = allocRegister();
+    emit(instr);
+}
+
+void ExprCompiler::emitTree(std::int32_t root) {
+    m_stack.push_back({ root, 0, -1, -1 });
+
+    while (!m_stack.empty()) {
+        const size_t top = m_stack.size() - 1;
+        const std::int32_t index = m_stack[top].node;
+        const ExprNode &node = m_tree.nodes[index];
+        const int stage = m_stack[top].stage;
+
+        if (stage == 0 && m_reg[index] >= 0) {
+            m_stack.pop_back();
+            continue;
+        }
+
+        if (node.op == ExprNode::Const) {
+            Instr instr;
+            instr.op = ExprProgram::LoadConst;
+            instr.imm = node.value;
+            instr.dst = m_reg[index] = allocRegister();
+            emit(instr);
+            m_stack.pop_back();
+            continue;
+        }
+
+        if (node.op == ExprNode::Select) {
+            // cond; JumpNone -> else; then; JumpAll -> take then; else; blend; Jump -> end; take then: move; end:
+            if (stage == 0) {
+                m_stack[top].stage = 1;
+                m_stack.push_back({ node.a, 0, -1, -1 });
+            } else if (stage == 1) {
+                Instr jump;
+                jump.op = ExprProgram::JumpNone;
+                jump.a = m_reg[node.a];
+                m_stack[top].jump = emit(jump);
+                m_stack[top].stage = 2;
+                m_stack[top].guard = m_guard;
+                if (m_integrates[node.b] && m_reg[node.b] < 0) enterArm(node.a, false);
+                m_stack.push_back({ node.b, 0, -1, -1 });
+            } else if (stage == 2) {
+                Instr jump;
+                jump.op = ExprProgram::JumpAll;
+                jump.a = m_reg[node.a];
+                const std::int32_t jumpAll = emit(jump);
+                m_program.m_code[m_stack[top].jump].dst = (std::int32_t)m_program.m_code.size();
+                m_stack[top].jump = jumpAll;
+                m_stack[top].stage = 3;
+                leaveArm(m_stack[top].guard, node.a);
+                if (m_integrates[node.c] && m_reg[node.c] < 0) enterArm(node.a, true);
+                m_stack.push_back({ node.c, 0, -1, -1 });
+            } else {
+                leaveArm(m_stack[top].guard, node.a);
+                const std::int32_t cond = m_reg[node.a], whenTrue = m_reg[node.b], whenFalse = m_reg[node.c];
+                consume(node.a);
+                consume(node.b);
+                consume(node.c);
+                const std::int32_t dst = m_reg[index] = allocRegister();
+
+                Instr blend;
+                blend.op = ExprProgram::Blend;
+                blend.dst = dst;
+                blend.a = cond;
+                blend.b = whenTrue;
+                blend.c = whenFalse;
+                emit(blend);
+                Instr jump;
+                jump.op = ExprProgram::Jump;
+                const std::int32_t toEnd = emit(jump);
+                m_program.m_code[m_stack[top].jump].dst = (std::int32_t)m_program.m_code.size();
+                Instr move;
+                move.op = ExprProgram::Move;
+                move.dst = dst;
+                move.a = whenTrue;
+                emit(move);
+                m_program.m_code[toEnd].dst = (std::int32_t)m_program.m_code.size();
+                m_stack.pop_back();
+            }
+            continue;
+        }
+
+        if (stage == 0) {
+            // Operands first, a before b before c; immediates need no code
+            m_stack[top].stage = 1;
+            const int side = immediateSide(node);
+            if (node.c >= 0) m_stack.push_back({ node.c, 0, -1, -1 });
+            if (node.b >= 0 && side != 2) m_stack.push_back({ node.b, 0, -1, -1 });
+            if (node.a >= 0 && side != 1) m_stack.push_back({ node.a, 0, -1, -1 });
+            continue;
+        }
+
+        if (node.op == ExprNode::Neg || node.op == ExprNode::Not) {
+            Instr instr;
+            instr.op = (node.op == ExprNode::Neg) ? ExprProgram::Neg : ExprProgram::Not;
+            instr.a = m_reg[node.a];
+            consume(node.a);
+            instr.dst = m_reg[index] = allocRegister();
+            emit(instr);
+        } else if (node.op == ExprNode::Call) {
+            emitCall(index, node);
+        } else {
+            emitBinary(index, node);
+        }
+        m_stack.pop_back();
+    }
+}
+
+void ExprCompiler::run() {
+    const size_t count = m_tree.nodes.size();
+    m_uses.assign(count, 0);
+    m_reg.assign(count, -1);
+    std::fill(std::begin(m_program.m_inputRegister), std::end(m_program.m_inputRegister), -1);
+
+    // Children precede parents, so one backwards pass finds what the root reaches
+    std::vector<char> reachable(count, 0);
+    reachable[m_tree.root] = 1;
+    m_uses[m_tree.root] = 1;
+    for (size_t i = count; i-- > 0;) {
+        if (!reachable[i]) continue;
+        const ExprNode &node = m_tree.nodes[i];
+        for (std::int32_t child : { node.a, node.b, node.c }) {
+            if (child < 0) continue;
+            reachable[child] = 1;
+            ++m_uses[child];
+        }
+    }
+    m_remaining = m_uses;
+    m_upFront.assign(count, 0);
+    for (size_t i = 0; i < count; ++i) m_upFront[i] = reachable[i] && m_uses[i] > 1;
+    for (const ExprBinding &binding : m_tree.bindings) {
+        if (binding.node >= 0 && reachable[binding.node]) m_upFront[binding.node] = 1;
+    }
+
+    // Up-front values are emitted ahead of any ternary, so only a node's own
+    // children carry an integrate() into it
+    m_integrates.assign(count, 0);
+    for (size_t i = 0; i < count; ++i) {
+        const ExprNode &node = m_tree.nodes[i];
+        char integrates = node.op == ExprNode::Call && node.index == ExprNode::Integrate;
+        for (std::int32_t child : { node.a, node.b, node.c }) {
+            if (child >= 0 && !m_upFront[child] && m_integrates[child]) integrates = 1;
+        }
+        m_integrates[i] = integrates;
+    }
+
+    // Inputs live in fixed registers, filled at the start of every block
+    for (size_t i = 0; i < count; ++i) {
+        const ExprNode &node = m_tree.nodes[i];
+        if (!reachable[i] || node.op != ExprNode::Variable) continue;
+        std::int32_t &reg = m_program.m_inputRegister[node.index];
+        if (reg < 0) reg = allocRegister();
+        m_reg[i] = reg;
+    }
+
+    // Up-front values first, in dependency order, then the root
+    for (size_t i = 0; i < count; ++i) {
+        if (m_upFront[i] && m_reg[i] < 0) emitTree((std::int32_t)i);
+    }
+    emitTree(m_tree.root);
+    m_program.m_output = m_reg[m_tree.root];
+}
+
+bool ExprProgram::compile(const ExprTree &tree, ExprProgram &program, std::string *error) {
+    program = ExprProgram();
+    if (!tree.isValid()) {
+        if (error) *error = "empty expression";
+        return false;
+    }
+    ExprCompiler compiler(tree, program);
+    compiler.run();
+    return true;
+}
+
+std::shared_ptr<const ExprProgram> ExprProgram::fromSource(const std::string &source, std::string *error, bool native) {
+    ExprTree tree;
+    ExprParseError parseError;
+    if (!ExprTree::parse(source, tree, &parseError)) {
+        if (error) *error = "Parse error at " + std::to_string(parseError.position) + ": " + parseError.message;
+        return nullptr;
+    }
+    return fromTree(tree, error, native);
+}
+
+std::shared_ptr<const ExprProgram> ExprProgram::fromTree(const ExprTree &tree, std::string *error, bool native) {
+    auto program = std::make_shared<ExprProgram>();
+    if (!compile(tree, *program, error)) return nullptr;
+    if (native) program->m_native = ExprNativeCode::compile(*program);
+    return program;
+}
+
+// --- INTERPRETER ---
+static inline double positiveFraction(double x) {
+    return x - std::floor(x);
+}
+
+// Stable per-index noise in [-1, 1), the same for every note
+static inline double randomCell(double x, double seed) {
+    std::uint32_t h = (std::uint32_t)(std::int64_t)x * 0x9E3779B1u ^ (std::uint32_t)(std::int64_t)seed * 0x85EBCA77u;
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    h *= 0x846CA68Bu;
+    h ^= h >> 16;
+    return (double)h / 2147483648.0 - 1.0;
+}
+
+static inline double triangle(double x) {
+    const double ph = positiveFraction(x);
+    if (ph <= 0.25) return ph * 4.0;
+    if (ph <= 0.75) return 2.0 - ph * 4.0;
+    return ph * 4.0 - 4.0;
+}
+
+template <typename F>
+static inline void map1(double *d, const double *a, int n, F f) {
+    for (int i = 0; i < n; ++i) d[i] = f(a[i]);
+}
+
+template <typename F>
+static inline void map2(double *d, const double *a, const double *b, int n, F f) {
+    for (int i = 0; i < n; ++i) d[i] = f(a[i], b[i]);
+}
+
+template <typename F>
+static inline void mapK(double *d, const double *a, double k, int n, F f) {
+    for (int i = 0; i < n; ++i) d[i] = f(a[i], k);
+}
+
+static void callFunc1(int func, double *d, const double *a, int n) {
+    const double twoPi = 6.283185307179586;
+    switch (func) {
+    case ExprNode::Sin:       map1(d, a, n, [](double x) { return std::sin(x); }); break;
+    case ExprNode::Cos:       map1(d, a, n, [](double x) { return std::cos(x); }); break;
+    case ExprNode::Tan:       map1(d, a, n, [](double x) { return std::tan(x); }); break;
+    case ExprNode::Asin:      map1(d, a, n, [](double x) { return std::asin(x); }); break;
+    case ExprNode::Acos:      map1(d, a, n, [](double x) { return std::acos(x); }); break;
+    case ExprNode::Atan:      map1(d, a, n, [](double x) { return std::atan(x); }); break;
+    case ExprNode::Sinh:      map1(d, a, n, [](double x) { return std::sinh(x); }); break;
+    case ExprNode::Cosh:      map1(d, a, n, [](double x) { return std::cosh(x); }); break;
+    case ExprNode::Tanh:      map1(d, a, n, [](double x) { return std::tanh(x); }); break;
+    case ExprNode::Exp:       map1(d, a, n, [](double x) { return std::exp(x); }); break;
+    case ExprNode::Log:       map1(d, a, n, [](double x) { return std::log(x); }); break;
+    case ExprNode::Log10:     map1(d, a, n, [](double x) { return std::log10(x); }); break;
+    case ExprNode::Log2:      map1(d, a, n, [](double x) { return std::log2(x); }); break;
+    case ExprNode::Sqrt:      map1(d, a, n, [](double x) { return std::sqrt(x); }); break;
+    case ExprNode::Abs:       map1(d, a, n, [](double x) { return std::fabs(x); }); break;
+    case ExprNode::Floor:     map1(d, a, n, [](double x) { return std::floor(x); }); break;
+    case ExprNode::Ceil:      map1(d, a, n, [](double x) { return std::ceil(x); }); break;
+    case ExprNode::Round:     map1(d, a, n, [](double x) { return std::round(x); }); break;
+    case ExprNode::Trunc:     map1(d, a, n, [](double x) { return std::trunc(x); }); break;
+    case ExprNode::Sgn:       map1(d, a, n, [](double x) { return (double)((x > 0.0) - (x < 0.0)); }); break;
+    case ExprNode::Sinew:     map1(d, a, n, [twoPi](double x) { return std::sin(twoPi * x); }); break;
+    case ExprNode::Saww:      map1(d, a, n, [](double x) { return 2.0 * positiveFraction(x) - 1.0; }); break;
+    case ExprNode::Squarew:   map1(d, a, n, [](double x) { return positiveFraction(x) >= 0.5 ? -1.0 : 1.0; }); break;
+    case ExprNode::Trianglew: map1(d, a, n, [](double x) { return triangle(x); }); break;
+    case ExprNode::Randv:     map1(d, a, n, [](double x) { return randomCell(x, 0.0); }); break;
+    case ExprNode::Semitone:  map1(d, a, n, [](double x) { return std::exp2(x / 12.0); }); break;
+    default:                  std::fill(d, d + n, 0.0); break;
+    }
+}
+
+static void callFunc2(int func, double *d, const double *a, const double *b, int n) {
+    switch (func) {
+    case ExprNode::Min:    map2(d, a, b, n, [](double x, double y) { return std::min(x, y); }); break;
+    case ExprNode::Max:    map2(d, a, b, n, [](double x, double y) { return std::max(x, y); }); break;
+    case ExprNode::Atan2:  map2(d, a, b, n, [](double x, double y) { return std::atan2(x, y); }); break;
+    case ExprNode::Randsv: map2(d, a, b, n, [](double x, double y) { return randomCell(x, y); }); break;
+    default:               std::fill(d, d + n, 0.0); break;
+    }
+}
+
+static bool anyLane(const double *a, int n) {
+    for (int i = 0; i < n; ++i) {
+        if (a[i] != 0.0) return true;
+    }
+    return false;
+}
+
+static bool allLanes(const double *a, int n) {
+    for (int i = 0; i < n; ++i) {
+        if (a[i] == 0.0) return false;
+    }
+    return true;
+}
+
+double ExprVM::evaluateFunction(ExprNode::Func func, double a, double b, double c) {
+    double result = 0.0;
+    switch (ExprNode::arity(func)) {
+    case 1:
+        if (!ExprNode::isStateful(func)) callFunc1(func, &result, &a, 1);
+        break;
+    case 2:
+        callFunc2(func, &result, &a, &b, 1);
+        break;
+    default:
+        result = std::min(std::max(b, a), c);
+        break;
+    }
+    return result;
+}
+
+ExprVM::ExprVM(std::shared_ptr<const ExprProgram> program) : m_program(std::move(program)) {
+    m_registers.assign((size_t)m_program->m_registers * ExprProgram::kLanes, 0.0);
+    m_integrators.assign(m_program->m_integrators, 0.0);
+    m_history.assign(m_program->m_historyLength, 0.0);
+}
+
+void ExprVM::reset() {
+    std::fill(m_integrators.begin(), m_integrators.end(), 0.0);
+    std::fill(m_history.begin(), m_history.end(), 0.0);
+    m_historyPos = 0;
+}
+
+void ExprVM::runBlock(int n, double t0, double dt, ParameterBank *knobs) {
+    const ExprProgram &program = *m_program;
+
+    // Inputs
+    const double *knob = knobs ? knobs->values() : m_inputs.knobs;
+    const double constants[ExprNode::InputCount] = {
+        0.0, m_inputs.frequency, 1.0 / dt, m_inputs.tempo, m_inputs.velocity, m_inputs.key,
+        m_inputs.release, m_inputs.releaseTime, knob[0], knob[1], knob[2]
+    };
+    for (int input = 0; input < ExprNode::InputCount; ++input) {
+        if (program.m_inputRegister[input] < 0) continue;
+        double *d = reg(program.m_inputRegister[input]);
+        if (input == ExprNode::Time) {
+            for (int i = 0; i < n; ++i) d[i] = t0 + i * dt;
+        } else {
+            std::fill(d, d + n, constants[input]);
+        }
+    }
+    if (knobs && knobs->isRamping()) {
+        // One tick per sample, before it, as ParametricSource does
+        double *d[3];
+        for (int k = 0; k < 3; ++k) {
+            const std::int32_t r = program.m_inputRegister[ExprNode::Knob1 + k];
+            d[k] = r >= 0 ? reg(r) : nullptr;
+        }
+        for (int i = 0; i < n; ++i) {
+            knobs->tick();
+            for (int k = 0; k < 3; ++k) {
+                if (d[k]) d[k][i] = knobs->values()[k];
+            }
+        }
+    }
+
+    if (program.m_native) {
+        program.m_native->run(*this, n, dt);
+        return;
+    }
+
+    const ExprProgram::Instr *code = program.m_code.data();
+    const size_t size = program.m_code.size();
+    for (size_t pc = 0; pc < size;) {
+        const ExprProgram::Instr &in = code[pc++];
+        switch (in.op) {
+        case ExprProgram::JumpNone:
+        case ExprProgram::JumpAll:
+            if (branchTaken(in, n)) pc = (size_t)in.dst;
+            break;
+        case ExprProgram::Jump:
+            pc = (size_t)in.dst;
+            break;
+        default:
+            execute(in, n, dt);
+            break;
+        }
+    }
+}
+
+bool ExprVM::branchTaken(const ExprProgram::Instr &in, int n) {
+    return in.op == ExprProgram::JumpNone ? !anyLane(reg(in.a), n) : allLanes(reg(in.a), n);
+}
+
+void ExprVM::execute(const ExprProgram::Instr &in, int n, double dt) {
+    double *d = reg(in.dst);
+    const double *a = in.a >= 0 ? reg(in.a) : nullptr;
+    const double *b = in.b >= 0 ? reg(in.b) : nullptr;
+    const double k = in.imm;
+
+    switch (in.op) {
+    case ExprProgram::LoadConst: std::fill(d, d + n, k); break;
+    case ExprProgram::Move:      if (d != a) std::copy(a, a + n, d); break;
+    case ExprProgram::Neg:       map1(d, a, n, [](double x) { return -x; }); break;
+    case ExprProgram::Not:       map1(d, a, n, [](double x) { return x == 0.0 ? 1.0 : 0.0; }); break;
+
+    case ExprProgram::Add: map2(d, a, b, n, [](double x, double y) { return x + y; }); break;
+    case ExprProgram::Sub: map2(d, a, b, n, [](double x, double y) { return x - y; }); break;
+    case ExprProgram::Mul: map2(d, a, b, n, [](double x, double y) { return x * y; }); break;
+    case ExprProgram::Div: map2(d, a, b, n, [](double x, double y) { return x / y; }); break;
+    case ExprProgram::Mod: map2(d, a, b, n, [](double x, double y) { return std::fmod(x, y); }); break;
+    case ExprProgram::Pow: map2(d, a, b, n, [](double x, double y) { return std::pow(x, y); }); break;
+    case ExprProgram::Lt:  map2(d, a, b, n, [](double x, double y) { return x < y ? 1.0 : 0.0; }); break;
+    case ExprProgram::Le:  map2(d, a, b, n, [](double x, double y) { return x <= y ? 1.0 : 0.0; }); break;
+    case ExprProgram::Gt:  map2(d, a, b, n, [](double x, double y) { return x > y ? 1.0 : 0.0; }); break;
+    case ExprProgram::Ge:  map2(d, a, b, n, [](double x, double y) { return x >= y ? 1.0 : 0.0; }); break;
+    case ExprProgram::Eq:  map2(d, a, b, n, [](double x, double y) { return x == y ? 1.0 : 0.0; }); break;
+    case ExprProgram::Ne:  map2(d, a, b, n, [](double x, double y) { return x != y ? 1.0 : 0.0; }); break;
+    case ExprProgram::And: map2(d, a, b, n, [](double x, double y) { return (x != 0.0 && y != 0.0) ? 1.0 : 0.0; }); break;
+    case ExprProgram::Or:  map2(d, a, b, n, [](double x, double y) { return (x != 0.0 || y != 0.0) ? 1.0 : 0.0; }); break;
+
+    case ExprProgram::AddK: mapK(d, a, k, n, [](double x, double y) { return x + y; }); break;
+    case ExprProgram::SubK: mapK(d, a, k, n, [](double x, double y) { return x - y; }); break;
+    case ExprProgram::KSub: mapK(d, a, k, n, [](double x, double y) { return y - x; }); break;
+    case ExprProgram::MulK: mapK(d, a, k, n, [](double x, double y) { return x * y; }); break;
+    case ExprProgram::DivK: mapK(d, a, k, n, [](double x, double y) { return x / y; }); break;
+    case ExprProgram::KDiv: mapK(d, a, k, n, [](double x, double y) { return y / x; }); break;
+    case ExprProgram::ModK: mapK(d, a, k, n, [](double x, double y) { return std::fmod(x, y); }); break;
+    case ExprProgram::PowK: mapK(d, a, k, n, [](double x, double y) { return std::pow(x, y); }); break;
+    case ExprProgram::LtK:  mapK(d, a, k, n, [](double x, double y) { return x < y ? 1.0 : 0.0; }); break;
+    case ExprProgram::LeK:  mapK(d, a, k, n, [](double x, double y) { return x <= y ? 1.0 : 0.0; }); break;
+    case ExprProgram::GtK:  mapK(d, a, k, n, [](double x, double y) { return x > y ? 1.0 : 0.0; }); break;
+    case ExprProgram::GeK:  mapK(d, a, k, n, [](double x, double y) { return x >= y ? 1.0 : 0.0; }); break;
+    case ExprProgram::EqK:  mapK(d, a, k, n, [](double x, double y) { return x == y ? 1.0 : 0.0; }); break;
+    case ExprProgram::NeK:  mapK(d, a, k, n, [](double x, double y) { return x != y ? 1.0 : 0.0; }); break;
+
+    case ExprProgram::Func1: callFunc1(in.func, d, a, n); break;
+    case ExprProgram::Func2: callFunc2(in.func, d, a, b, n); break;
+    case ExprProgram::Clamp: {
+        const double *c = reg(in.c);
+        for (int i = 0; i < n; ++i) d[i] = std::min(std::max(b[i], a[i]), c[i]);
+        break;
+    }
+    case ExprProgram::Integrate: {
+        // Phase at the start of each sample, so integrate(f) starts at 0
+        double acc = m_integrators[in.c];
+        if (b) {
+            for (int i = 0; i < n; ++i) {
+                const double x = a[i], guard = b[i];     // d may share a's register
+                d[i] = acc;
+                if (guard != 0.0) acc += x * dt;
+            }
+        } else {
+            for (int i = 0; i < n; ++i) {
+                const double x = a[i];
+                d[i] = acc;
+                acc += x * dt;
+            }
+        }
+        m_integrators[in.c] = acc;
+        break;
+    }
+    case ExprProgram::Last: {
+        // Blocks are never longer than the nearest offset, so lane i only
+        // reaches outputs that earlier blocks have already written
+        const int length = (int)m_history.size();
+        const std::size_t mask = (std::size_t)length - 1;
+        for (int i = 0; i < n; ++i) {
+            d[i] = m_history[(m_historyPos + i - (std::size_t)lastOffset(a[i], length)) & mask];
+        }
+        break;
+    }
+    case ExprProgram::Blend: {
+        const double *c = reg(in.c);
+        for (int i = 0; i < n; ++i) d[i] = a[i] != 0.0 ? b[i] : c[i];
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void ExprVM::render(float *out, int frames, double t0, double dt, ParameterBank *knobs) {
+    const int block = m_program->m_blockLimit;
+    const std::size_t mask = m_history.size() - 1;
+    for (int done = 0; done < frames; done += block) {
+        const int n = std::min(block, frames - done);
+        runBlock(n, t0 + done * dt, dt, knobs);
+        const double *result = reg(m_program->m_output);
+        for (int i = 0; i < n; ++i) out[done + i] = (float)result[i];
+        if (!m_history.empty()) {
+            for (int i = 0; i < n; ++i) m_history[(m_historyPos + i) & mask] = result[i];
+            m_historyPos = (m_historyPos + n) & mask;
+        }
+    }
+}
+
+// --- EXPRESSION SOURCE ---
+ExpressionSource::ExpressionSource(std::shared_ptr<const ExprProgram> program, const ExprInputs &inputs)
+    : m_vm(std::move(program)) {
+    m_vm.setInputs(inputs);
+    for (int k = 0; k < 3; ++k) m_knobs.reset(k, inputs.knobs[k]);
+}
+
+ExpressionSource::ExpressionSource(std::shared_ptr<const ExprProgram> left, std::shared_ptr<const ExprProgram> right,
+                                   const ExprInputs &inputs)
+    : ExpressionSource(std::move(left), inputs) {
+    m_right = std::make_unique<ExprVM>(std::move(right));
+    m_right->setInputs(inputs);
+}
+
+// Mono of a pair is the mix of both outputs, as StereoFunctionSource plays it
+void ExpressionSource::render(float *out, int frames, double t0, double dt) {
+    if (!m_right) {
+        m_vm.render(out, frames, t0, dt, &m_knobs);
+        return;
+    }
+    float right[ExprProgram::kLanes];
+    for (int done = 0; done < frames; done += ExprProgram::kLanes) {
+        const int n = std::min(ExprProgram::kLanes, frames - done);
+        ParameterBank knobs = m_knobs;
+        m_vm.render(out + done, n, t0 + done * dt, dt, &knobs);
+        m_right->render(right, n, t0 + done * dt, dt, &m_knobs);
+        for (int i = 0; i < n; ++i) out[done + i] = 0.5f * (out[done + i] + right[i]);
+    }
+}
+
+// Both sides see the same knob ramp: O1 ticks a copy, O2 the bank itself
+void ExpressionSource::renderStereo(float *left, float *right, int frames, double t0, double dt) {
+    if (!m_right) {
+        AudioSource::renderStereo(left, right, frames, t0, dt);
+        return;
+    }
+    ParameterBank knobs = m_knobs;
+    m_vm.render(left, frames, t0, dt, &knobs);
+    m_right->render(right, frames, t0, dt, &m_knobs);
+}
+
+bool ExpressionSource::isStateless() const {
+    return m_vm.program()->isStateless() && (!m_right || m_right->program()->isStateless()) && !m_knobs.isRamping();
+}
+
+std::unique_ptr<AudioSource> ExpressionSource::cloneForThread() const {
+    std::unique_ptr<ExpressionSource> copy = m_right
+        ? std::make_unique<ExpressionSource>(m_vm.program(), m_right->program(), m_vm.inputs())
+        : std::make_unique<ExpressionSource>(m_vm.program(), m_vm.inputs());
+    copy->m_knobs = m_knobs;
+    return copy;
+}
+
+void ExpressionSource::applyParameter(const ParamCommand &cmd, double sampleRate) {
+    if (cmd.slot >= 3) return;
+    m_knobs.set(cmd.slot, cmd.value, (int)std::lround(cmd.rampSeconds * sampleRate));
+}
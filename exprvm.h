@@ -0,0 +1,177 @@
+#ifndef EXPRVM_H
+#define EXPRVM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "audiosource.h"
+#include "exprtree.h"
+
+class ExprNativeCode;
+
+// ==============================================================================
+// EXPRESSION BYTECODE
+// ==============================================================================
+// A parsed expression compiled to a register machine whose registers are
+// blocks of kLanes doubles (structure of arrays). One dispatch evaluates an
+// operation for a whole block, so the interpreter overhead is paid once per
+// 128 samples and the inner loops are plain arrays the compiler vectorises.
+//
+// Ternaries compile to branches on the whole block: when every lane agrees,
+// only the taken side runs, which is what keeps binary-search PCM trees at
+// O(depth) work per block. Mixed blocks run both sides and blend per lane;
+// an integrate() in either side only advances on the lanes that chose it.
+// A `var` value runs on every sample, wherever it is read, as in exprtk.
+
+// Per-note values the host supplies; t and srate come from the render call
+struct ExprInputs {
+    double frequency = 440.0;
+    double tempo = 120.0;
+    double velocity = 1.0;
+    double key = 69.0;
+    double release = 0.0;
+    double releaseTime = 0.0;
+    double knobs[3] = { 0.0, 0.0, 0.0 };
+};
+
+class ExprProgram {
+public:
+    static constexpr int kLanes = 128;
+    // Longest last() history a voice keeps, in samples (about 3 s at 44.1 kHz).
+    // Offsets computed at run time get all of it; constant ones only what they reach.
+    static constexpr int kMaxHistory = 1 << 17;
+
+    // Never recurses. Only fails on an empty tree.
+    static bool compile(const ExprTree &tree, ExprProgram &program, std::string *error = nullptr);
+    // Parse and compile in one go; nullptr (and the parser's message) on failure.
+    // native also lowers the bytecode to machine code when the CPU allows it.
+    static std::shared_ptr<const ExprProgram> fromSource(const std::string &source, std::string *error = nullptr,
+                                                         bool native = false);
+    // The same for a tree that is already parsed
+    static std::shared_ptr<const ExprProgram> fromTree(const ExprTree &tree, std::string *error = nullptr,
+                                                       bool native = false);
+
+    int instructionCount() const { return (int)m_code.size(); }
+    int registerCount() const { return m_registers; }
+    // Bytes held by the bytecode, for cache budgets
+    std::size_t memoryUsage() const { return sizeof(*this) + m_code.capacity() * sizeof(Instr); }
+    // integrate() and last() make the output depend on everything rendered before
+    bool isStateless() const { return m_integrators == 0 && !m_usesHistory; }
+    // Output samples each voice remembers for last(); 0 without last()
+    int historyLength() const { return m_historyLength; }
+    // Longest block that can run before last() would read a sample of the same
+    // block: the smallest constant offset, or 1 if an offset is computed
+    int blockLimit() const { return m_blockLimit; }
+    // Set when fromSource() lowered the program; ExprVM then runs it natively
+    const ExprNativeCode *nativeCode() const { return m_native.get(); }
+
+private:
+    friend class ExprCompiler;
+    friend class ExprVM;
+    friend class ExprAssembler;
+    friend class ExprNativeCode;
+
+    enum Opcode : std::uint8_t {
+        LoadConst, Move,
+        Neg, Not,
+        Add, Sub, Mul, Div, Mod, Pow, Lt, Le, Gt, Ge, Eq, Ne, And, Or,
+        // Second operand is the immediate; KSub and KDiv have it first
+        AddK, SubK, KSub, MulK, DivK, KDiv, ModK, PowK, LtK, LeK, GtK, GeK, EqK, NeK,
+        Func1, Func2, Clamp,
+        Integrate,      // c = accumulator index, b = lanes that advance it (-1: all)
+        Last,
+        Blend,          // dst = a ? b : c, per lane
+        JumpNone,       // to dst if no lane of a is set
+        JumpAll,        // to dst if every lane of a is set
+        Jump
+    };
+
+    struct Instr {
+        Opcode op = LoadConst;
+        std::uint8_t func = 0;      // ExprNode::Func for Func1 / Func2
+        std::int32_t dst = -1;
+        std::int32_t a = -1;
+        std::int32_t b = -1;
+        std::int32_t c = -1;
+        double imm = 0.0;
+    };
+
+    std::vector<Instr> m_code;
+    std::int32_t m_inputRegister[ExprNode::InputCount] = {};   // -1 when unused
+    std::int32_t m_output = -1;
+    int m_registers = 0;
+    int m_integrators = 0;
+    bool m_usesHistory = false;
+    int m_historyLength = 0;
+    int m_blockLimit = kLanes;
+    std::shared_ptr<const ExprNativeCode> m_native;
+};
+
+// Execution state for one voice of a program: registers, one accumulator per
+// integrate() call site and a ring of past outputs for last(). All of it is
+// sized from the program when the VM is built, so rendering never allocates.
+class ExprVM {
+public:
+    explicit ExprVM(std::shared_ptr<const ExprProgram> program);
+
+    // Back to note-on: integrators and output history cleared
+    void reset();
+    void setInputs(const ExprInputs &inputs) { m_inputs = inputs; }
+    const ExprInputs &inputs() const { return m_inputs; }
+    const std::shared_ptr<const ExprProgram> &program() const { return m_program; }
+
+    // Sample i is the value at t0 + i * dt; srate is 1 / dt. With knobs, A1-A3
+    // come from its slots 0-2 instead of inputs(), ticked once per sample, so
+    // a ramp moves within the block rather than stepping at its start.
+    void render(float *out, int frames, double t0, double dt, ParameterBank *knobs = nullptr);
+
+    // One value of a stateless function exactly as render() computes it, for
+    // folding constants at compile time. 0 for integrate() and last().
+    static double evaluateFunction(ExprNode::Func func, double a, double b = 0.0, double c = 0.0);
+
+private:
+    friend class ExprNativeCode;
+
+    void runBlock(int lanes, double t0, double dt, ParameterBank *knobs);
+    // One non-branch instruction over the first lanes of its registers
+    void execute(const ExprProgram::Instr &in, int lanes, double dt);
+    // Whether a JumpNone / JumpAll goes to its target
+    bool branchTaken(const ExprProgram::Instr &in, int lanes);
+    double *reg(std::int32_t index) { return m_registers.data() + (size_t)index * ExprProgram::kLanes; }
+
+    std::shared_ptr<const ExprProgram> m_program;
+    ExprInputs m_inputs;
+    std::vector<double> m_registers;
+    std::vector<double> m_integrators;
+    std::vector<double> m_history;      // Power-of-two ring of past outputs
+    std::size_t m_historyPos = 0;       // Where the next output sample goes
+};
+
+// --- EXPRESSION SOURCE ---
+// Plays a compiled expression in the engine, or an O1/O2 pair in stereo (O1
+// left, O2 right, one voice each, both rendered in the same call). Mixer
+// parameter slots 0-2 drive the A1-A3 knobs, smoothed per sample like
+// ParametricSource's. Stateless when no program uses integrate() or last()
+// and no knob is ramping; the VM registers are still scratch, so each extra
+// offline render thread gets its own copy.
+class ExpressionSource : public AudioSource {
+public:
+    explicit ExpressionSource(std::shared_ptr<const ExprProgram> program, const ExprInputs &inputs = ExprInputs());
+    ExpressionSource(std::shared_ptr<const ExprProgram> left, std::shared_ptr<const ExprProgram> right,
+                     const ExprInputs &inputs = ExprInputs());
+    void render(float *out, int frames, double t0, double dt) override;
+    void renderStereo(float *left, float *right, int frames, double t0, double dt) override;
+    bool isStereo() const override { return m_right != nullptr; }
+    bool isStateless() const override;
+    std::unique_ptr<AudioSource> cloneForThread() const override;
+    void applyParameter(const ParamCommand &cmd, double sampleRate) override;
+
+private:
+    ExprVM m_vm;
+    std::unique_ptr<ExprVM> m_right;     // O2; nullptr when mono
+    ParameterBank m_knobs;
+};
+
+#endif // EXPRVM_H
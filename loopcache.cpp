@@ -0,0 +1,123 @@
+#include "loopcache.h"
+#include <QMetaObject>
+#include <algorithm>
+#include <cmath>
+
+// --- LOOP BUFFER ---
+LoopBuffer::LoopBuffer(std::vector<float> samples, double sampleRate, double period)
+    : m_samples(std::move(samples)), m_sampleRate(sampleRate), m_period(period) {}
+
+double LoopBuffer::valueAt(double t) const {
+    if (m_samples.size() < 2) return 0.0;
+    double local = std::fmod(t, m_period);
+    if (local < 0.0) local += m_period;
+
+    const double pos = local * m_sampleRate;
+    const size_t i0 = std::min((size_t)pos, m_samples.size() - 2);
+    const double frac = pos - (double)i0;
+    return m_samples[i0] + (m_samples[i0 + 1] - m_samples[i0]) * frac;
+}
+
+// --- LOOP PLAYBACK ---
+LoopBufferSource::LoopBufferSource(std::shared_ptr<const LoopBuffer> buffer)
+    : m_buffer(std::move(buffer)) {}
+
+void LoopBufferSource::render(float *out, int frames, double t0, double dt) {
+    const std::vector<float> &samples = m_buffer->m_samples;
+    if (samples.size() < 2) {
+        std::fill(out, out + frames, 0.0f);
+        return;
+    }
+
+    // Same phase as the live function: fmod on the engine clock, not on a
+    // whole number of samples, so fractional periods don't drift
+    const double sr = m_buffer->m_sampleRate;
+    const double periodSamples = m_buffer->m_period * sr;
+    const double step = dt * sr;
+    double pos = std::fmod(t0, m_buffer->m_period) * sr;
+    if (pos < 0.0) pos += periodSamples;
+
+    const size_t last = samples.size() - 2;
+    const float *src = samples.data();
+    for (int i = 0; i < frames; ++i) {
+        const size_t i0 = std::min((size_t)pos, last);
+        const float frac = (float)(pos - (double)i0);
+        out[i] = src[i0] + (src[i0 + 1] - src[i0]) * frac;
+
+        pos += step;
+        if (pos >= periodSamples) pos -= periodSamples;
+    }
+}
+
+// --- BACKGROUND RENDERER ---
+LoopRenderer::LoopRenderer(QObject *parent) : QObject(parent) {
+    m_worker = std::thread(&LoopRenderer::workerMain, this);
+}
+
+LoopRenderer::~LoopRenderer() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+    m_latestTicket.store(0, std::memory_order_release);
+    m_wake.notify_one();
+    m_worker.join();
+}
+
+quint64 LoopRenderer::request(std::function<double(double)> func, double period, double sampleRate) {
+    if (!func || period <= 0.0 || period > kMaxPeriodSeconds || sampleRate <= 0.0) {
+        cancel();
+        return 0;
+    }
+
+    const quint64 ticket = ++m_nextTicket;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_job.func = std::move(func);
+        m_job.period = period;
+        m_job.sampleRate = sampleRate;
+        m_job.ticket = ticket;
+        m_hasJob = true;
+    }
+    // Publishing the ticket first aborts whatever the worker is rendering now
+    m_latestTicket.store(ticket, std::memory_order_release);
+    m_wake.notify_one();
+    return ticket;
+}
+
+void LoopRenderer::cancel() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_hasJob = false;
+    m_latestTicket.store(0, std::memory_order_release);
+}
+
+void LoopRenderer::workerMain() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_quit || m_hasJob; });
+            if (m_quit) return;
+            job = std::move(m_job);
+            m_hasJob = false;
+        }
+
+        // One period plus the guard sample
+        const size_t count = (size_t)std::ceil(job.period * job.sampleRate) + 1;
+        std::vector<float> samples(count);
+        bool superseded = false;
+        for (size_t i = 0; i < count && !superseded; ++i) {
+            const double v = job.func((double)i / job.sampleRate);
+            samples[i] = (std::isnan(v) || std::isinf(v)) ? 0.0f : (float)v;
+            if ((i & 4095) == 4095) superseded = m_latestTicket.load(std::memory_order_acquire) != job.ticket;
+        }
+        if (superseded || m_latestTicket.load(std::memory_order_acquire) != job.ticket) continue;
+
+        auto buffer = std::make_shared<const LoopBuffer>(std::move(samples), job.sampleRate, job.period);
+        const quint64 ticket = job.ticket;
+        QMetaObject::invokeMethod(this, [this, ticket, buffer] {
+            // Still the newest by the time it reaches the GUI thread?
+            if (ticket == m_latestTicket.load(std::memory_order_acquire)) emit ready(ticket, buffer);
+        }, Qt::QueuedConnection);
+    }
+}
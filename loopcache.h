@@ -0,0 +1,89 @@
+#ifndef LOOPCACHE_H
+#define LOOPCACHE_H
+
+#include <QObject>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "audiosource.h"
+
+// ==============================================================================
+// LOOP CACHE
+// ==============================================================================
+// Many previews are deterministic loops (drum retriggers, SFX repeats, step
+// gates): f(t) == f(t + period). For those, one period is rendered once on a
+// worker thread and then played and drawn by table lookup until the
+// parameters change, so the steady-state preview costs next to nothing.
+
+// One rendered period, plus a guard sample so interpolation never wraps early
+class LoopBuffer {
+public:
+    LoopBuffer(std::vector<float> samples, double sampleRate, double period);
+
+    double valueAt(double t) const;
+    double period() const { return m_period; }
+    double sampleRate() const { return m_sampleRate; }
+
+private:
+    friend class LoopBufferSource;
+    std::vector<float> m_samples;
+    double m_sampleRate;
+    double m_period;
+};
+
+// Plays a LoopBuffer in step with the engine clock, so it lines up exactly with
+// the live function it replaces
+class LoopBufferSource : public AudioSource {
+public:
+    explicit LoopBufferSource(std::shared_ptr<const LoopBuffer> buffer);
+    void render(float *out, int frames, double t0, double dt) override;
+    bool isStateless() const override { return true; }
+
+private:
+    std::shared_ptr<const LoopBuffer> m_buffer;
+};
+
+// --- BACKGROUND RENDERER ---
+// Latest request wins: a new request aborts the one in progress, and only the
+// newest result is ever delivered (on the thread this object lives on).
+class LoopRenderer : public QObject {
+    Q_OBJECT
+public:
+    // Longer periods are not worth the memory; they keep playing live
+    static constexpr double kMaxPeriodSeconds = 30.0;
+
+    explicit LoopRenderer(QObject *parent = nullptr);
+    ~LoopRenderer() override;
+
+    // Returns a ticket identifying the result, or 0 if the period can't be cached
+    quint64 request(std::function<double(double)> func, double period, double sampleRate);
+    void cancel();
+
+signals:
+    void ready(quint64 ticket, std::shared_ptr<const LoopBuffer> buffer);
+
+private:
+    void workerMain();
+
+    struct Job {
+        std::function<double(double)> func;
+        double period = 0.0;
+        double sampleRate = 0.0;
+        quint64 ticket = 0;
+    };
+
+    std::thread m_worker;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    Job m_job;                      // Guarded by m_mutex
+    bool m_hasJob = false;          // Guarded by m_mutex
+    bool m_quit = false;            // Guarded by m_mutex
+    std::atomic<quint64> m_latestTicket { 0 };
+    quint64 m_nextTicket = 0;       // GUI thread only
+};
+
+#endif // LOOPCACHE_H
@@ -0,0 +1,97 @@
+#include "previewrecorder.h"
+#include "audiobackend.h"
+#include <QDebug>
+#include <algorithm>
+#include <chrono>
+
+// RIFF sizes are 32-bit; stop a little short of 4 GiB instead of wrapping
+static constexpr quint64 kMaxDataBytes = 0xFFFFFFFFull - 36;
+
+PreviewRecorder::PreviewRecorder(const QString &fileName, const QAudioFormat &format)
+    : m_fileName(fileName), m_format(format), m_file(fileName) {}
+
+PreviewRecorder::~PreviewRecorder() {
+    stop();
+}
+
+bool PreviewRecorder::start() {
+    const int bytesPerFrame = m_format.bytesPerFrame();
+    if (bytesPerFrame <= 0 || !m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "[Recorder] Cannot open" << m_fileName << "for writing";
+        return false;
+    }
+
+    m_ring.reset((size_t)(kRingSeconds * m_format.sampleRate()) * bytesPerFrame);
+    m_chunk.resize(m_ring.capacity() / 4);
+    m_dataBytes.store(0, std::memory_order_relaxed);
+    m_droppedBytes.store(0, std::memory_order_relaxed);
+    writeHeader();
+
+    m_running.store(true, std::memory_order_release);
+    m_writer = std::thread(&PreviewRecorder::writerMain, this);
+    return true;
+}
+
+void PreviewRecorder::stop() {
+    if (!m_writer.joinable()) return;
+    m_running.store(false, std::memory_order_release);
+    m_writer.join();
+
+    drain();
+    writeHeader();
+    m_file.close();
+}
+
+void PreviewRecorder::write(const char *data, qint64 len) {
+    // All or nothing, so a dropped block can never shift the channel order
+    if ((qint64)m_ring.writeAvailable() < len) {
+        m_droppedBytes.fetch_add(len, std::memory_order_relaxed);
+        return;
+    }
+    m_ring.write(data, (size_t)len);
+}
+
+double PreviewRecorder::recordedSeconds() const {
+    const int bytesPerFrame = m_format.bytesPerFrame();
+    if (bytesPerFrame <= 0 || m_format.sampleRate() <= 0) return 0.0;
+    return (double)m_dataBytes.load(std::memory_order_relaxed) / bytesPerFrame / m_format.sampleRate();
+}
+
+// --- DISK WRITER THREAD ---
+void PreviewRecorder::writerMain() {
+    auto lastHeader = std::chrono::steady_clock::now();
+
+    while (m_running.load(std::memory_order_acquire)) {
+        drain();
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now - lastHeader >= std::chrono::milliseconds(kHeaderIntervalMs)) {
+            writeHeader();
+            lastHeader = now;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(kPollIntervalMs));
+    }
+}
+
+void PreviewRecorder::drain() {
+    const int bytesPerFrame = m_format.bytesPerFrame();
+    quint64 written = m_dataBytes.load(std::memory_order_relaxed);
+
+    while (size_t got = m_ring.read(m_chunk.data(), m_chunk.size())) {
+        // Past the RIFF limit: keep emptying the ring, but stop growing the file
+        const quint64 room = kMaxDataBytes - written;
+        qint64 keep = (qint64)std::min<quint64>(got, room);
+        keep -= keep % bytesPerFrame;
+        if (keep > 0) written += (quint64)std::max<qint64>(m_file.write(m_chunk.data(), keep), 0);
+        if ((qint64)got > keep) m_droppedBytes.fetch_add((qint64)got - keep, std::memory_order_relaxed);
+    }
+    m_dataBytes.store(written, std::memory_order_relaxed);
+}
+
+void PreviewRecorder::writeHeader() {
+    const qint64 end = m_file.pos();
+    m_file.seek(0);
+    m_file.write(WavFileBackend::wavHeader(m_format, (quint32)m_dataBytes.load(std::memory_order_relaxed)));
+    m_file.seek(std::max<qint64>(end, 44));
+    m_file.flush();
+}
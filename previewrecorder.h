@@ -0,0 +1,55 @@
+#ifndef PREVIEWRECORDER_H
+#define PREVIEWRECORDER_H
+
+#include <QAudioFormat>
+#include <QFile>
+#include <QString>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "spscqueue.h"
+
+// --- PREVIEW RECORDER ---
+// Captures the exact bytes SynthEngine hands to the device into a WAV file.
+// The audio thread only copies into a lock-free ring; a background thread
+// drains it to disk and rewrites the header about once a second, so a crash
+// or a pulled plug still leaves a playable file. Memory is bounded by the ring
+// (a few seconds of audio): if the disk falls that far behind, whole blocks
+// are dropped and counted rather than blocking the callback.
+class PreviewRecorder {
+public:
+    PreviewRecorder(const QString &fileName, const QAudioFormat &format);
+    ~PreviewRecorder();
+
+    bool start();
+    // Drains what's left, patches the header and closes the file
+    void stop();
+
+    // Audio thread only. Never blocks or allocates.
+    void write(const char *data, qint64 len);
+
+    QString fileName() const { return m_fileName; }
+    double recordedSeconds() const;
+    qint64 droppedBytes() const { return m_droppedBytes.load(std::memory_order_relaxed); }
+
+private:
+    void writerMain();
+    void drain();
+    void writeHeader();
+
+    static constexpr double kRingSeconds = 4.0;
+    static constexpr int kHeaderIntervalMs = 1000;
+    static constexpr int kPollIntervalMs = 20;
+
+    QString m_fileName;
+    QAudioFormat m_format;
+    QFile m_file;
+    SpscByteRing m_ring;
+    std::vector<char> m_chunk;
+    std::thread m_writer;
+    std::atomic<bool> m_running { false };
+    std::atomic<quint64> m_dataBytes { 0 };   // Written to disk, writer thread only stores
+    std::atomic<qint64> m_droppedBytes { 0 };
+};
+
+#endif // PREVIEWRECORDER_H
@@ -0,0 +1,116 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+// --- SINGLE PRODUCER / SINGLE CONSUMER QUEUE ---
+// Fixed-capacity, wait-free ring used to hand data between the GUI thread and
+// the audio thread. Exactly one thread may push and exactly one thread may pop.
+// Never allocates after construction, so it is safe to use from readData().
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscQueue capacity must be a power of two");
+
+public:
+    bool push(T value) {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        const std::size_t tail = m_tail.load(std::memory_order_acquire);
+        if (head - tail >= Capacity) return false;
+        m_items[head & (Capacity - 1)] = std::move(value);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T &out) {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        const std::size_t head = m_head.load(std::memory_order_acquire);
+        if (tail == head) return false;
+        out = std::move(m_items[tail & (Capacity - 1)]);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Only meaningful from the producer side (space can only grow behind it).
+    std::size_t freeSpace() const {
+        return Capacity - (m_head.load(std::memory_order_relaxed) - m_tail.load(std::memory_order_acquire));
+    }
+
+    bool isEmpty() const {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+private:
+    T m_items[Capacity] {};
+    alignas(64) std::atomic<std::size_t> m_head { 0 };
+    alignas(64) std::atomic<std::size_t> m_tail { 0 };
+};
+
+// --- SINGLE PRODUCER / SINGLE CONSUMER BYTE RING ---
+// Bulk variant for streaming audio: one thread writes blocks of bytes, another
+// reads them. Storage is sized by reset(), which must only be called while
+// neither side is running.
+class SpscByteRing {
+public:
+    void reset(std::size_t minCapacity) {
+        std::size_t capacity = 64;
+        while (capacity < minCapacity) capacity <<= 1;
+        m_storage.assign(capacity, 0);
+        m_mask = capacity - 1;
+        m_head.store(0, std::memory_order_relaxed);
+        m_tail.store(0, std::memory_order_relaxed);
+    }
+
+    std::size_t capacity() const { return m_storage.size(); }
+
+    std::size_t readAvailable() const {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_relaxed);
+    }
+
+    std::size_t writeAvailable() const {
+        return capacity() - (m_head.load(std::memory_order_relaxed) - m_tail.load(std::memory_order_acquire));
+    }
+
+    std::size_t write(const char *data, std::size_t len) {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        len = std::min(len, writeAvailable());
+        copyIn(head, data, len);
+        m_head.store(head + len, std::memory_order_release);
+        return len;
+    }
+
+    std::size_t read(char *data, std::size_t len) {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        len = std::min(len, readAvailable());
+        copyOut(tail, data, len);
+        m_tail.store(tail + len, std::memory_order_release);
+        return len;
+    }
+
+private:
+    void copyIn(std::size_t pos, const char *data, std::size_t len) {
+        const std::size_t offset = pos & m_mask;
+        const std::size_t first = std::min(len, capacity() - offset);
+        std::memcpy(m_storage.data() + offset, data, first);
+        std::memcpy(m_storage.data(), data + first, len - first);
+    }
+
+    void copyOut(std::size_t pos, char *data, std::size_t len) const {
+        const std::size_t offset = pos & m_mask;
+        const std::size_t first = std::min(len, capacity() - offset);
+        std::memcpy(data, m_storage.data() + offset, first);
+        std::memcpy(data + first, m_storage.data(), len - first);
+    }
+
+    std::vector<char> m_storage;
+    std::size_t m_mask = 0;
+    alignas(64) std::atomic<std::size_t> m_head { 0 };
+    alignas(64) std::atomic<std::size_t> m_tail { 0 };
+};
+
+#endif // SPSCQUEUE_H
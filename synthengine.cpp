@@ -1,98 +1,1019 @@
-#include "synthengine.h"
-#include <QDebug>
-#include <QtEndian>
-#include <QMutexLocker>
-#include <QDebug>
-
-SynthEngine::SynthEngine(QObject *parent) : QIODevice(parent) {
-    m_format.setSampleRate(44100);
-    m_format.setChannelCount(2);
-    m_format.setSampleFormat(QAudioFormat::Float);
-
-    QAudioDevice device = QMediaDevices::defaultAudioOutput();
-    if (!device.isFormatSupported(m_format)) {
-        m_format = device.preferredFormat();
-    }
-    m_audioSink = new QAudioSink(device, m_format, this);
-    m_audioSink->setBufferSize(16384);
-
-    open(QIODevice::ReadOnly);
-    m_audioSink->start(this);
-}
-
-SynthEngine::~SynthEngine() {
-    m_audioSink->stop();
-    close();
-    delete m_audioSink;
-}
-
-bool SynthEngine::isSequential() const { return true; }
-
-qint64 SynthEngine::bytesAvailable() const {
-    if (!isOpen()) return 0;
-    return m_audioSink->bufferSize() + QIODevice::bytesAvailable();
-}
-
-void SynthEngine::start() {
-    QMutexLocker locker(&m_mutex);
-    m_totalSamples = 0;
-    m_isPlaying = true;
-}
-void SynthEngine::stop() {
-    QMutexLocker locker(&m_mutex);
-    m_isPlaying = false;
-}
-
-void SynthEngine::setAudioSource(std::function<double(double)> func) {
-    QMutexLocker locker(&m_mutex);
-    m_oscillator = func;
-}
-
-void SynthEngine::setExpression(QString code) {
-    m_currentCode = code;
-}
-
-qint64 SynthEngine::readData(char *data, qint64 maxlen) {
-    QMutexLocker locker(&m_mutex);
-
-
-    memset(data, 0, maxlen);
-
-    int channels = m_format.channelCount();
-    if (channels == 0) return maxlen;
-
-    if (m_format.sampleFormat() == QAudioFormat::Float) {
-        float *buffer = reinterpret_cast<float*>(data);
-        int frames = maxlen / (sizeof(float) * channels);
-
-        for (int i = 0; i < frames; ++i) {
-            float sample = 0.0f;
-
-            if (m_isPlaying && m_oscillator) {
-                double t = (double)m_totalSamples / m_format.sampleRate();
-
-
-                if (m_totalSamples < 5) {
-                    qDebug() << "[AUDIO] Fetching sample for time:" << t;
-                }
-
-                sample = (float)m_oscillator(t) * 0.5f;
-
-                if (std::isnan(sample) || std::isinf(sample)) sample = 0.0f;
-                m_totalSamples++;
-            }
-
-            for (int c = 0; c < channels; ++c) {
-                *buffer++ = sample;
-            }
-        }
-    }
-
-
-    return maxlen;
-}
-
-qint64 SynthEngine::writeData(const char *data, qint64 len) {
-    Q_UNUSED(data);
-    return len;
-}
+#include "synthengine.h"
+#include "exprcache.h"
+#include <QDebug>
+#include <QtEndian>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#if defined(Q_OS_WIN)
+#define NOMINMAX
+#include <windows.h>
+#elif defined(Q_OS_UNIX)
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include <QFile>
+#include <QDataStream>
+
+SynthEngine::SynthEngine(QObject *parent) : QIODevice(parent) {
+    // Retired sources are freed here, well away from the audio callback
+    m_reclaimTimer = new QTimer(this);
+    m_reclaimTimer->setInterval(250);
+    connect(m_reclaimTimer, &QTimer::timeout, this, &SynthEngine::reclaimRetiredSources);
+    m_reclaimTimer->start();
+
+    m_loopRenderer = new LoopRenderer(this);
+    connect(m_loopRenderer, &LoopRenderer::ready, this, &SynthEngine::adoptLoopCache);
+
+    open(QIODevice::ReadOnly);
+    setBackend(AudioBackend::createFromEnvironment());
+}
+
+// --- LATENCY PROFILES ---
+// aheadPeriods is how many render periods the render thread keeps queued in the ring
+struct LatencySettings { double bufferMs; int periodFrames; int aheadPeriods; };
+
+static LatencySettings latencySettings(SynthEngine::LatencyProfile profile) {
+    switch (profile) {
+    case SynthEngine::LowLatency: return { 10.0, 128, 3 };
+    case SynthEngine::Balanced:   return { 25.0, 256, 4 };
+    case SynthEngine::Safe:       return { 93.0, 512, 8 };
+    }
+    return { 25.0, 256, 4 };
+}
+
+void SynthEngine::openBackend() {
+    // Qt 6 only exposes the total buffer size; the period is our own render block
+    const LatencySettings settings = latencySettings(m_latencyProfile);
+    const int bytesPerFrame = std::max(1, m_format.bytesPerFrame());
+    const qint64 frames = (qint64)(settings.bufferMs * 0.001 * m_format.sampleRate());
+    m_periodFrames = std::min(settings.periodFrames, kBlockFrames);
+
+    // Render thread and backend are both stopped here, so the ring can be resized
+    m_periodBuffer.assign((size_t)m_periodFrames * bytesPerFrame, 0);
+    m_ringTargetBytes = m_periodBuffer.size() * settings.aheadPeriods;
+    m_ring.reset(m_ringTargetBytes + m_periodBuffer.size());
+
+    // A freewheeling backend has no deadline to render ahead of
+    m_freewheel = m_backend->isFreewheeling();
+    if (!m_freewheel) startRenderThread();
+
+    if (!m_backend->start(this, m_format, std::max<qint64>(frames, m_periodFrames * 2) * bytesPerFrame)) {
+        qWarning() << "[Audio] Backend failed to start:" << m_backend->name();
+    }
+}
+
+void SynthEngine::closeBackend() {
+    if (m_backend) m_backend->stop();
+    stopRenderThread();
+}
+
+void SynthEngine::setBackend(std::unique_ptr<AudioBackend> backend) {
+    if (!backend) return;
+    stopRecording();
+    closeBackend();
+    if (m_backend) disconnect(m_backend.get(), nullptr, this, nullptr);
+
+    m_backend = std::move(backend);
+    connect(m_backend.get(), &AudioBackend::underrun, this, &SynthEngine::handleBackendUnderrun);
+
+    // Float at the engine rate is the cheap path. Anything else the device prefers
+    // is handled by the resampler and the integer writers in renderPeriod().
+    QAudioFormat wanted;
+    wanted.setSampleRate(44100);
+    wanted.setChannelCount(2);
+    wanted.setSampleFormat(QAudioFormat::Float);
+    m_format = m_backend->negotiateFormat(wanted);
+    m_resampler.setRates(m_sampleRate, m_format.sampleRate());
+
+    openBackend();
+    resetStats();
+}
+
+// --- RECORDING ---
+bool SynthEngine::startRecording(const QString &fileName) {
+    stopRecording();
+    auto recorder = std::make_unique<PreviewRecorder>(fileName, m_format);
+    if (!recorder->start()) return false;
+
+    m_recorderOwner = std::move(recorder);
+    m_recorder.store(m_recorderOwner.get(), std::memory_order_seq_cst);
+    return true;
+}
+
+void SynthEngine::stopRecording() {
+    if (!m_recorderOwner) return;
+
+    // Once the pointer is cleared and the tap is idle, readData() can no
+    // longer be inside the recorder
+    m_recorder.store(nullptr, std::memory_order_seq_cst);
+    while (m_tapBusy.load(std::memory_order_seq_cst)) std::this_thread::yield();
+
+    m_recorderOwner->stop();
+    m_recorderOwner.reset();
+}
+
+double SynthEngine::recordedSeconds() const {
+    return m_recorderOwner ? m_recorderOwner->recordedSeconds() : 0.0;
+}
+
+void SynthEngine::setLatencyProfile(LatencyProfile profile) {
+    if (profile == m_latencyProfile) return;
+    m_latencyProfile = profile;
+
+    // A sink's buffer size is fixed once started, so swap in a fresh one
+    closeBackend();
+    openBackend();
+    resetStats();
+}
+
+bool SynthEngine::setParameter(int slot, double value, double rampSeconds) {
+    if (slot < 0 || slot >= ParameterBank::kMaxParams) return false;
+    ParamCommand cmd;
+    cmd.slot = (std::uint16_t)slot;
+    cmd.value = (float)value;
+    cmd.rampSeconds = (float)std::max(0.0, rampSeconds);
+    return m_paramCommands.push(cmd);
+}
+
+void SynthEngine::setOversampling(int factor) {
+    const int clamped = (factor >= 8) ? 8 : (factor >= 4 ? 4 : (factor >= 2 ? 2 : 1));
+    m_oversamplingRequest.store(clamped, std::memory_order_relaxed);
+}
+
+void SynthEngine::setCpuGuardEnabled(bool enabled) {
+    m_cpuGuardEnabled.store(enabled, std::memory_order_relaxed);
+    if (enabled) return;
+    // Turning the guard off gives every slot its full rate back
+    for (MixerSlot &slot : m_slots) slot.degrade.store(GuardNormal, std::memory_order_relaxed);
+}
+
+void SynthEngine::setCrossfadeTime(double seconds) {
+    m_crossfadeSeconds.store((float)std::clamp(seconds, 0.0, 1.0), std::memory_order_relaxed);
+}
+
+double SynthEngine::crossfadeTime() const {
+    return m_crossfadeSeconds.load(std::memory_order_relaxed);
+}
+
+double SynthEngine::outputLatencyMs() const {
+    const int bytesPerFrame = m_format.bytesPerFrame();
+    if (!m_backend || bytesPerFrame <= 0 || m_format.sampleRate() <= 0) return 0.0;
+    const qint64 queued = m_backend->bytesQueued() + (qint64)m_ring.readAvailable();
+    return 1000.0 * (double)std::max<qint64>(queued, 0) / bytesPerFrame / m_format.sampleRate();
+}
+
+SynthEngine::~SynthEngine() {
+    closeBackend();
+    stopRecording();
+    close();
+    m_backend.reset();
+
+    // Backend and render thread are stopped, so nothing else can touch the sources now
+    reclaimRetiredSources();
+    for (MixerSlot &slot : m_slots) {
+        delete slot.pending.exchange(nullptr);
+        delete slot.active;
+        delete slot.fading;
+        slot.active = nullptr;
+        slot.fading = nullptr;
+    }
+}
+
+bool SynthEngine::isSequential() const { return true; }
+
+qint64 SynthEngine::bytesAvailable() const {
+    if (!isOpen()) return 0;
+    return (m_backend ? m_backend->bufferSize() : 0) + QIODevice::bytesAvailable();
+}
+
+void SynthEngine::start() {
+    m_resetClock.store(true, std::memory_order_release);
+    m_isPlaying.store(true, std::memory_order_release);
+}
+void SynthEngine::stop() {
+    m_isPlaying.store(false, std::memory_order_release);
+}
+
+void SynthEngine::setAudioSource(std::function<double(double)> func) {
+    setAudioSource(std::make_unique<FunctionSource>(std::move(func)));
+}
+
+void SynthEngine::setAudioSource(std::unique_ptr<AudioSource> source) {
+    m_voiceController.reset();
+    ++m_sourceSerial;
+    if (m_loopTicket) {
+        m_loopRenderer->cancel();
+        m_loopTicket = 0;
+    }
+    setSlotSource(0, std::move(source));
+}
+
+// --- LOOP CACHE ---
+quint64 SynthEngine::setAudioSource(std::function<double(double)> func, double loopPeriod) {
+    setAudioSource(func);
+    m_loopSerial = m_sourceSerial;
+    m_loopTicket = m_loopRenderer->request(std::move(func), loopPeriod, m_sampleRate);
+    return m_loopTicket;
+}
+
+void SynthEngine::adoptLoopCache(quint64 ticket, std::shared_ptr<const LoopBuffer> buffer) {
+    // Only if the live source it was rendered for is still the main preview
+    if (ticket != m_loopTicket || m_sourceSerial != m_loopSerial) return;
+    m_loopTicket = 0;
+
+    // Straight into slot 0: to the tabs this is still the same source
+    setSlotSource(0, std::make_unique<LoopBufferSource>(buffer));
+    emit loopCacheReady(ticket, buffer);
+}
+
+// --- MIXER ---
+void SynthEngine::setSlotSource(int slot, std::unique_ptr<AudioSource> source) {
+    if (slot < 0 || slot >= kMixerSlots) return;
+    if (!source) {
+        clearSlot(slot);
+        return;
+    }
+    m_slotUsed[slot] = true;
+
+    // If the audio thread never picked up the previous pending source it is
+    // still ours, so it can be dropped right here on the GUI thread.
+    delete m_slots[slot].pending.exchange(source.release(), std::memory_order_acq_rel);
+
+    reclaimRetiredSources();
+}
+
+void SynthEngine::clearSlot(int slot) {
+    if (slot < 0 || slot >= kMixerSlots) return;
+    if (slot == 0) ++m_sourceSerial;
+    m_slotUsed[slot] = false;
+    delete m_slots[slot].pending.exchange(nullptr, std::memory_order_acq_rel);
+    m_slots[slot].clearRequest.store(true, std::memory_order_release);
+}
+
+void SynthEngine::setSlotGain(int slot, double gain) {
+    if (slot < 0 || slot >= kMixerSlots) return;
+    m_slots[slot].gain.store((float)std::clamp(gain, 0.0, 4.0), std::memory_order_relaxed);
+}
+
+double SynthEngine::slotGain(int slot) const {
+    if (slot < 0 || slot >= kMixerSlots) return 0.0;
+    return m_slots[slot].gain.load(std::memory_order_relaxed);
+}
+
+void SynthEngine::setSlotMuted(int slot, bool muted) {
+    if (slot < 0 || slot >= kMixerSlots) return;
+    m_slots[slot].muted.store(muted, std::memory_order_relaxed);
+}
+
+bool SynthEngine::isSlotMuted(int slot) const {
+    if (slot < 0 || slot >= kMixerSlots) return false;
+    return m_slots[slot].muted.load(std::memory_order_relaxed);
+}
+
+bool SynthEngine::isSlotUsed(int slot) const {
+    if (slot < 0 || slot >= kMixerSlots) return false;
+    return m_slotUsed[slot];
+}
+
+int SynthEngine::layerMainSource() {
+    if (!m_slotUsed[0] || m_layerRequest.load(std::memory_order_acquire) != 0) return -1;
+
+    int target = -1;
+    for (int i = 1; i < kMixerSlots && target < 0; ++i) {
+        if (!m_slotUsed[i]) target = i;
+    }
+    if (target < 0) return -1;
+
+    m_slots[target].gain.store(1.0f, std::memory_order_relaxed);
+    m_slots[target].muted.store(false, std::memory_order_relaxed);
+
+    if (AudioSource *pending = m_slots[0].pending.exchange(nullptr, std::memory_order_acq_rel)) {
+        // Published but not adopted yet: it goes straight to the layer, and
+        // whatever slot 0 still plays fades out
+        delete m_slots[target].pending.exchange(pending, std::memory_order_acq_rel);
+        m_slots[0].clearRequest.store(true, std::memory_order_release);
+    } else {
+        m_layerRequest.store(target, std::memory_order_release);
+    }
+
+    m_slotUsed[target] = true;
+    m_slotUsed[0] = false;
+    ++m_sourceSerial;
+    return target;
+}
+
+void SynthEngine::clearLayers() {
+    for (int i = 1; i < kMixerSlots; ++i) {
+        if (m_slotUsed[i]) clearSlot(i);
+    }
+}
+
+void SynthEngine::setStereoSource(StereoFunc func) {
+    setAudioSource(std::make_unique<StereoFunctionSource>(std::move(func)));
+}
+
+std::shared_ptr<VoiceController> SynthEngine::setVoiceSource(VoicePatch patch, int maxVoices) {
+    auto voices = std::make_unique<VoiceManager>(std::move(patch), maxVoices);
+    std::shared_ptr<VoiceController> controller = voices->controller();
+    setAudioSource(std::move(voices));
+    m_voiceController = controller;
+    return controller;
+}
+
+std::shared_ptr<VoiceController> SynthEngine::setVoiceSource(std::shared_ptr<const ExprProgram> program,
+                                                             const ExprInputs &inputs, int maxVoices) {
+    auto voices = std::make_unique<VoiceManager>(std::move(program), inputs, maxVoices);
+    std::shared_ptr<VoiceController> controller = voices->controller();
+    setAudioSource(std::move(voices));
+    m_voiceController = controller;
+    return controller;
+}
+
+void SynthEngine::reclaimRetiredSources() {
+    AudioSource *retired = nullptr;
+    while (m_retiredSources.pop(retired)) {
+        delete retired;
+    }
+}
+
+void SynthEngine::handleBackendUnderrun() {
+    m_statUnderruns.fetch_add(1, std::memory_order_relaxed);
+}
+
+// --- TELEMETRY ---
+void SynthEngine::recordCallback(qint64 frames, double seconds) {
+    if (frames <= 0) return;
+    const double budget = (double)frames / m_format.sampleRate();
+    const double load = seconds / budget;
+
+    int bin = 0;
+    while (bin < EngineStats::kHistogramBins - 1 && load >= EngineStats::kBinEdges[bin]) ++bin;
+    m_statHistogram[bin].fetch_add(1, std::memory_order_relaxed);
+
+    if (load > 1.0) m_statOverruns.fetch_add(1, std::memory_order_relaxed);
+    m_statCallbacks.fetch_add(1, std::memory_order_relaxed);
+    m_statFrames.fetch_add((quint64)frames, std::memory_order_relaxed);
+
+    // Only this thread writes the load values, so load/store is enough
+    const float smoothed = m_statLoad.load(std::memory_order_relaxed);
+    m_statLoad.store(smoothed + 0.1f * ((float)load - smoothed), std::memory_order_relaxed);
+    if ((float)load > m_statPeakLoad.load(std::memory_order_relaxed)) {
+        m_statPeakLoad.store((float)load, std::memory_order_relaxed);
+    }
+}
+
+EngineStats SynthEngine::stats() const {
+    EngineStats s;
+    s.callbacks = m_statCallbacks.load(std::memory_order_relaxed);
+    s.budgetOverruns = m_statOverruns.load(std::memory_order_relaxed);
+    s.framesRendered = m_statFrames.load(std::memory_order_relaxed);
+    s.sampleRate = m_format.sampleRate();
+    s.outputLatencyMs = outputLatencyMs();
+    s.ringUnderruns = m_statRingUnderruns.load(std::memory_order_relaxed);
+    s.realtimePriority = m_statRealtime.load(std::memory_order_relaxed);
+    if (m_backend && m_format.bytesPerFrame() > 0) {
+        s.bufferMs = 1000.0 * m_backend->bufferSize() / m_format.bytesPerFrame() / m_format.sampleRate();
+    }
+    s.underruns = m_statUnderruns.load(std::memory_order_relaxed);
+    s.cpuLoad = m_statLoad.load(std::memory_order_relaxed) * 100.0;
+    s.peakLoad = m_statPeakLoad.load(std::memory_order_relaxed) * 100.0;
+    if (m_recorderOwner) {
+        s.recording = true;
+        s.recordedSeconds = m_recorderOwner->recordedSeconds();
+        s.recordDroppedBytes = m_recorderOwner->droppedBytes();
+    }
+    if (m_voiceController) {
+        s.activeVoices = m_voiceController->activeVoices();
+        s.perVoiceLoad = m_voiceController->perVoiceLoad();
+    }
+    for (int i = 0; i < EngineStats::kHistogramBins; ++i) {
+        s.histogram[i] = m_statHistogram[i].load(std::memory_order_relaxed);
+    }
+    for (int i = 0; i < kMixerSlots; ++i) {
+        s.slotLoad[i] = m_slots[i].load.load(std::memory_order_relaxed);
+        s.slotDegrade[i] = m_slots[i].degrade.load(std::memory_order_relaxed);
+        if (i > 0 && m_slotUsed[i]) ++s.activeLayers;
+    }
+    return s;
+}
+
+void SynthEngine::resetStats() {
+    m_statCallbacks.store(0, std::memory_order_relaxed);
+    m_statOverruns.store(0, std::memory_order_relaxed);
+    m_statFrames.store(0, std::memory_order_relaxed);
+    m_statUnderruns.store(0, std::memory_order_relaxed);
+    m_statRingUnderruns.store(0, std::memory_order_relaxed);
+    m_statPeakLoad.store(0.0f, std::memory_order_relaxed);
+    for (auto &bin : m_statHistogram) bin.store(0, std::memory_order_relaxed);
+}
+
+bool SynthEngine::setExpression(const QString &code, QString *error) {
+    std::string message;
+    std::shared_ptr<const ExprProgram> program = ExprCache::shared().program(code.toStdString(), &message, m_nativeExpressions);
+    if (!program) {
+        if (error) *error = QString::fromStdString(message);
+        return false;
+    }
+    m_currentCode = code;
+    setAudioSource(std::make_unique<ExpressionSource>(std::move(program)));
+    return true;
+}
+
+qint64 SynthEngine::readData(char *data, qint64 maxlen) {
+    const int bytesPerFrame = std::max(1, m_format.bytesPerFrame());
+    const qint64 wanted = maxlen - maxlen % bytesPerFrame;
+
+    // Freewheeling: no deadline, so render exactly what was asked for right here
+    if (m_freewheel) {
+        const auto start = std::chrono::steady_clock::now();
+        const int frames = (int)(wanted / bytesPerFrame);
+        renderPeriod(data, frames);
+        memset(data + wanted, 0, maxlen - wanted);
+        recordCallback(frames, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        tapRecorder(data, wanted);
+        return maxlen;
+    }
+
+    // Everything was rendered ahead of time by the render thread; only whole
+    // frames are taken so the channel order can never slip
+    qint64 got = (qint64)m_ring.read(data, (size_t)wanted);
+    got -= got % bytesPerFrame;
+
+    if (got < maxlen) {
+        memset(data + got, 0, maxlen - got);
+        if (got < wanted) m_statRingUnderruns.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    m_renderWake.notify_one();
+    tapRecorder(data, wanted);
+    return maxlen;
+}
+
+void SynthEngine::tapRecorder(const char *data, qint64 len) {
+    m_tapBusy.store(true, std::memory_order_seq_cst);
+    if (PreviewRecorder *recorder = m_recorder.load(std::memory_order_seq_cst)) {
+        recorder->write(data, len);
+    }
+    m_tapBusy.store(false, std::memory_order_release);
+}
+
+// =========================================================
+// RENDER THREAD
+// =========================================================
+static bool promoteToRealtimePriority() {
+#if defined(Q_OS_WIN)
+    return SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL) != 0;
+#elif defined(Q_OS_UNIX)
+    // Needs rtprio / CAP_SYS_NICE on Linux; without it we stay at normal priority
+    sched_param param {};
+    param.sched_priority = std::max(sched_get_priority_min(SCHED_FIFO), sched_get_priority_max(SCHED_FIFO) / 2);
+    return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+#else
+    return false;
+#endif
+}
+
+void SynthEngine::startRenderThread() {
+    m_renderRunning.store(true, std::memory_order_release);
+    m_renderThread = std::thread(&SynthEngine::renderThreadMain, this);
+}
+
+void SynthEngine::stopRenderThread() {
+    if (!m_renderThread.joinable()) return;
+    m_renderRunning.store(false, std::memory_order_release);
+    m_renderWake.notify_one();
+    m_renderThread.join();
+}
+
+void SynthEngine::renderThreadMain() {
+    m_statRealtime.store(promoteToRealtimePriority(), std::memory_order_relaxed);
+
+    const size_t periodBytes = m_periodBuffer.size();
+    const auto periodDuration = std::chrono::duration<double>((double)m_periodFrames / m_format.sampleRate());
+    const auto idleWait = std::chrono::duration_cast<std::chrono::microseconds>(periodDuration / 2);
+
+    while (m_renderRunning.load(std::memory_order_acquire)) {
+        if (m_ring.readAvailable() + periodBytes <= m_ringTargetBytes) {
+            const auto start = std::chrono::steady_clock::now();
+            renderPeriod(m_periodBuffer.data(), m_periodFrames);
+            m_ring.write(m_periodBuffer.data(), periodBytes);
+            recordCallback(m_periodFrames, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+            updateCpuGuard(m_periodFrames);
+            continue;
+        }
+
+        // Ring is full enough; sleep until the device drains some of it
+        std::unique_lock<std::mutex> lock(m_renderWakeMutex);
+        m_renderWake.wait_for(lock, idleWait);
+    }
+}
+
+void SynthEngine::renderPeriod(char *data, int frames) {
+    const bool playing = m_isPlaying.load(std::memory_order_acquire);
+
+    const int oversampling = m_oversamplingRequest.load(std::memory_order_relaxed);
+    if (oversampling != m_oversampler.factor()) m_oversampler.setFactor(oversampling);
+
+    updateSlots(playing);
+
+    if (m_resetClock.exchange(false, std::memory_order_acq_rel)) {
+        m_totalSamples = 0;
+        m_resampler.reset();
+        m_oversampler.reset();
+        for (MixerSlot &slot : m_slots) {
+            if (slot.fading && m_retiredSources.push(slot.fading)) slot.fading = nullptr;
+            slot.fadeRemaining = 0;
+        }
+    }
+
+    const int channels = m_format.channelCount();
+    const int bytesPerFrame = m_format.bytesPerFrame();
+    if (channels <= 0) return;     // No usable format negotiated: nothing to write
+
+    // Render at the engine rate, resample to the device rate, then interleave
+    // and convert to whatever sample format the device accepted. Mono devices get
+    // the L/R average; channels beyond the first two carry the centre.
+    char *dst = data;
+    for (int done = 0; done < frames; ) {
+        const int n = std::min({ kBlockFrames, frames - done, kInterleavedSamples / channels });
+        renderDeviceBlock(m_leftBuffer, m_rightBuffer, n, playing);
+
+        float *out = m_interleaved;
+        for (int i = 0; i < n; ++i) {
+            const float l = m_leftBuffer[i], r = m_rightBuffer[i];
+            if (channels == 1) {
+                *out++ = 0.5f * (l + r);
+                continue;
+            }
+            *out++ = l;
+            *out++ = r;
+            for (int c = 2; c < channels; ++c) *out++ = 0.5f * (l + r);
+        }
+        writeDeviceSamples(m_interleaved, dst, n * channels);
+
+        dst += (qint64)n * bytesPerFrame;
+        done += n;
+    }
+}
+
+// --- MIXER SLOTS ---
+void SynthEngine::updateSlots(bool playing) {
+    // Replaced sources are only handed back when the retire queue has room for
+    // them (including one still fading out), otherwise the change simply waits
+    // for the next period. Clears go first so a later publish is never undone.
+    for (MixerSlot &slot : m_slots) {
+        if (m_retiredSources.freeSpace() < 2) return;
+        if (slot.clearRequest.exchange(false, std::memory_order_acq_rel)) adoptSource(slot, nullptr, playing);
+    }
+
+    const int target = m_layerRequest.load(std::memory_order_acquire);
+    if (target > 0 && target < kMixerSlots) {
+        if (m_retiredSources.freeSpace() < 2) return;
+        MixerSlot &from = m_slots[0];
+        MixerSlot &to = m_slots[target];
+        if (to.active) m_retiredSources.push(to.active);
+        if (to.fading) m_retiredSources.push(to.fading);
+
+        // The layer carries on exactly where the main preview was
+        to.active = from.active;
+        to.fading = from.fading;
+        to.fadeLength = from.fadeLength;
+        to.fadeRemaining = from.fadeRemaining;
+        to.appliedGain = from.appliedGain;
+        to.degrade.store(from.degrade.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        from.degrade.store(GuardNormal, std::memory_order_relaxed);
+        to.load.store(from.load.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        from.active = nullptr;
+        from.fading = nullptr;
+        from.fadeRemaining = 0;
+        from.appliedGain = 0.0f;
+        from.load.store(0.0f, std::memory_order_relaxed);
+        m_layerRequest.store(0, std::memory_order_release);
+    }
+
+    for (MixerSlot &slot : m_slots) {
+        if (m_retiredSources.freeSpace() < (slot.fading ? 2u : 1u)) return;
+        if (AudioSource *incoming = slot.pending.exchange(nullptr, std::memory_order_acq_rel)) {
+            adoptSource(slot, incoming, playing);
+        }
+    }
+}
+
+// --- CROSSFADING ---
+// incoming may be null, which fades the slot out to silence
+void SynthEngine::adoptSource(MixerSlot &slot, AudioSource *incoming, bool playing) {
+    // An empty slot fades its new source in through its gain ramp
+    if (!slot.active && !slot.fading) slot.appliedGain = 0.0f;
+
+    // Slider drags keep the guard's verdict; a muted slot gets one more chance
+    // at the lowest rate, and a cleared slot starts over
+    if (!incoming) slot.degrade.store(GuardNormal, std::memory_order_relaxed);
+    else if (slot.degrade.load(std::memory_order_relaxed) == GuardMuted) slot.degrade.store(GuardQuarterRate, std::memory_order_relaxed);
+
+    // A fade that is still running loses its oldest source; with slider drags the
+    // neighbouring sources are nearly identical, so the jump is inaudible
+    if (slot.fading) {
+        m_retiredSources.push(slot.fading);
+        slot.fading = nullptr;
+    }
+
+    const int fadeFrames = (int)(m_crossfadeSeconds.load(std::memory_order_relaxed) * renderRate());
+    if (slot.active && playing && m_playGain > 0.0f && slot.appliedGain > 0.0f && fadeFrames > 0) {
+        slot.fading = slot.active;
+        slot.fadeLength = slot.fadeRemaining = fadeFrames;
+    } else if (slot.active) {
+        m_retiredSources.push(slot.active);
+    }
+    slot.active = incoming;
+
+    // Knob moves that arrived while this source was waiting to be picked up
+    if (&slot == &m_slots[0]) {
+        for (int i = 0; incoming && i < ParameterBank::kMaxParams; ++i) {
+            if (m_heldParamMask & (1u << i)) incoming->applyParameter(m_heldParams[i], renderRate());
+        }
+        m_heldParamMask = 0;
+    }
+}
+
+void SynthEngine::mixCrossfade(MixerSlot &slot, float *left, float *right, int frames) {
+    // Linear: consecutive sources are usually the same patch with a nudged
+    // parameter, so their sum stays at unity gain
+    const float inv = 1.0f / (float)slot.fadeLength;
+    for (int i = 0; i < frames; ++i) {
+        float in = 1.0f;
+        if (slot.fadeRemaining > 0) {
+            in = (float)(slot.fadeLength - slot.fadeRemaining) * inv;
+            --slot.fadeRemaining;
+        }
+        left[i] = m_fadeLeft[i] + (left[i] - m_fadeLeft[i]) * in;
+        right[i] = m_fadeRight[i] + (right[i] - m_fadeRight[i]) * in;
+    }
+
+    if (slot.fadeRemaining == 0 && m_retiredSources.push(slot.fading)) {
+        slot.fading = nullptr;
+    }
+}
+
+// Knob moves go to every slot 0 source that can still be heard: the active one
+// and the one fading out. A source that is published but not adopted yet can't
+// be touched from here, so the latest value per parameter waits for it.
+void SynthEngine::drainParamCommands(double sampleRate) {
+    MixerSlot &slot = m_slots[0];
+    ParamCommand cmd;
+    while (m_paramCommands.pop(cmd)) {
+        if (slot.active) slot.active->applyParameter(cmd, sampleRate);
+        if (slot.fading) slot.fading->applyParameter(cmd, sampleRate);
+        if (slot.pending.load(std::memory_order_acquire)) {
+            m_heldParams[cmd.slot] = cmd;
+            m_heldParamMask |= 1u << cmd.slot;
+        }
+    }
+}
+
+void SynthEngine::renderSlots(float *left, float *right, int frames, double t0, double dt) {
+    std::fill(left, left + frames, 0.0f);
+    std::fill(right, right + frames, 0.0f);
+
+    // Ramps are counted in samples at whatever rate this call renders at
+    drainParamCommands(1.0 / dt);
+
+    const float fade = m_crossfadeSeconds.load(std::memory_order_relaxed);
+    const float rampStep = fade > 0.0f ? (float)(dt / fade) : 1.0f;
+    const double budget = frames * dt;
+
+    for (MixerSlot &slot : m_slots) {
+        if (!slot.active && !slot.fading) continue;
+
+        // A muted slot that has finished ramping down costs nothing
+        const int degrade = slot.degrade.load(std::memory_order_relaxed);
+        const bool muted = slot.muted.load(std::memory_order_relaxed) || degrade == GuardMuted;
+        const float target = muted ? 0.0f : slot.gain.load(std::memory_order_relaxed);
+        if (target == 0.0f && slot.appliedGain == 0.0f) {
+            if (slot.fading && m_retiredSources.push(slot.fading)) slot.fading = nullptr;
+            slot.load.store(0.0f, std::memory_order_relaxed);
+            continue;
+        }
+
+        const int factor = (degrade == GuardHalfRate) ? 2 : (degrade == GuardQuarterRate ? 4 : 1);
+        const auto begin = std::chrono::steady_clock::now();
+        if (slot.active) {
+            renderReduced(slot.active, m_slotLeft, m_slotRight, frames, t0, dt, factor, slot.prev);
+        } else {
+            std::fill(m_slotLeft, m_slotLeft + frames, 0.0f);
+            std::fill(m_slotRight, m_slotRight + frames, 0.0f);
+        }
+        if (slot.fading) {
+            renderReduced(slot.fading, m_fadeLeft, m_fadeRight, frames, t0, dt, factor, slot.fadePrev);
+            mixCrossfade(slot, m_slotLeft, m_slotRight, frames);
+        }
+
+        float gain = slot.appliedGain;
+        for (int i = 0; i < frames; ++i) {
+            if (gain < target) gain = std::min(target, gain + rampStep);
+            else if (gain > target) gain = std::max(target, gain - rampStep);
+            left[i] += m_slotLeft[i] * gain;
+            right[i] += m_slotRight[i] * gain;
+        }
+        slot.appliedGain = gain;
+
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        const float cost = (float)(100.0 * seconds / budget);
+        const float smoothed = slot.load.load(std::memory_order_relaxed);
+        slot.load.store(smoothed + 0.1f * (cost - smoothed), std::memory_order_relaxed);
+    }
+}
+
+// Renders the last sample of every group of factor samples and interpolates
+// the rest linearly from the previous group's last one. Each rendered sample
+// is the value at its own time, so nothing is delayed, and the source never
+// sees time run backwards (stateful sources integrate over t). A block that
+// isn't a whole number of groups renders its last frames % factor samples at
+// full rate.
+void SynthEngine::renderReduced(AudioSource *source, float *left, float *right, int frames, double t0, double dt,
+                                int factor, float *prev) {
+    if (frames <= 0) return;
+    const int reduced = factor > 1 ? frames / factor : 0;
+    const int whole = reduced * factor;
+    if (reduced == 0) {
+        source->renderStereo(left, right, frames, t0, dt);
+        prev[0] = left[frames - 1];
+        prev[1] = right[frames - 1];
+        return;
+    }
+
+    source->renderStereo(left, right, reduced, t0 + (factor - 1) * dt, dt * factor);
+
+    // Expand in place from the back: output j * factor + q only overwrites
+    // reduced samples that have already been consumed
+    const float lastL = left[reduced - 1], lastR = right[reduced - 1];
+    const float inv = 1.0f / (float)factor;
+    for (int j = reduced - 1; j >= 0; --j) {
+        const float l1 = left[j], r1 = right[j];
+        const float l0 = j > 0 ? left[j - 1] : prev[0];
+        const float r0 = j > 0 ? right[j - 1] : prev[1];
+        for (int q = factor - 1; q >= 0; --q) {
+            const float frac = (float)(q + 1) * inv;
+            left[j * factor + q] = l0 + (l1 - l0) * frac;
+            right[j * factor + q] = r0 + (r1 - r0) * frac;
+        }
+    }
+    prev[0] = lastL;
+    prev[1] = lastR;
+
+    // The expansion only wrote [0, whole), so the tail goes straight after it
+    if (whole < frames) {
+        source->renderStereo(left + whole, right + whole, frames - whole, t0 + whole * dt, dt);
+        prev[0] = left[frames - 1];
+        prev[1] = right[frames - 1];
+    }
+}
+
+// --- CPU GUARD ---
+void SynthEngine::updateCpuGuard(int frames) {
+    if (!m_cpuGuardEnabled.load(std::memory_order_relaxed)) return;
+
+    const double seconds = (double)frames / m_format.sampleRate();
+    const float load = m_statLoad.load(std::memory_order_relaxed);
+    m_guardHoldoff = std::max(0.0, m_guardHoldoff - seconds);
+    m_guardOverSeconds = (load > kGuardHighLoad) ? m_guardOverSeconds + seconds : 0.0;
+    m_guardUnderSeconds = (load < kGuardLowLoad) ? m_guardUnderSeconds + seconds : 0.0;
+
+    // Give the smoothed load time to react before judging the last change
+    if (m_guardHoldoff > 0.0) return;
+
+    if (m_guardOverSeconds >= kGuardEscalateSeconds) {
+        // Degrade whichever audible slot costs the most right now
+        MixerSlot *heaviest = nullptr;
+        for (MixerSlot &slot : m_slots) {
+            if (!slot.active || slot.degrade.load(std::memory_order_relaxed) == GuardMuted) continue;
+            if (!heaviest || slot.load.load(std::memory_order_relaxed) > heaviest->load.load(std::memory_order_relaxed)) {
+                heaviest = &slot;
+            }
+        }
+        if (heaviest) heaviest->degrade.fetch_add(1, std::memory_order_relaxed);
+        m_guardOverSeconds = 0.0;
+        m_guardHoldoff = 0.5;
+    } else if (m_guardUnderSeconds >= kGuardRelaxSeconds) {
+        // Headroom again: give the most reduced slot its rate back one step
+        MixerSlot *reduced = nullptr;
+        for (MixerSlot &slot : m_slots) {
+            const int stage = slot.degrade.load(std::memory_order_relaxed);
+            if (stage == GuardNormal || stage == GuardMuted) continue;
+            if (!reduced || stage > reduced->degrade.load(std::memory_order_relaxed)) reduced = &slot;
+        }
+        if (reduced) reduced->degrade.fetch_sub(1, std::memory_order_relaxed);
+        m_guardUnderSeconds = 0.0;
+        m_guardHoldoff = 1.0;
+    }
+}
+
+void SynthEngine::renderDeviceBlock(float *left, float *right, int frames, bool playing) {
+    bool busy = false;
+    for (const MixerSlot &slot : m_slots) busy = busy || slot.active || slot.fading;
+
+    // Keep rendering after stop() until the output ramp has reached zero
+    if (!busy || (!playing && m_playGain <= 0.0f)) {
+        // Still drain parameter updates so none go stale while stopped
+        drainParamCommands(renderRate());
+        std::fill(left, left + frames, 0.0f);
+        std::fill(right, right + frames, 0.0f);
+        return;
+    }
+
+    const double dt = 1.0 / m_sampleRate;
+    m_resampler.pull(left, right, frames, [this, dt](float *l, float *r, int n) {
+        const double t0 = (double)m_totalSamples * dt;
+        if (m_oversampler.factor() > 1) renderOversampled(l, r, n, t0, dt);
+        else renderSlots(l, r, n, t0, dt);
+        m_totalSamples += n;
+    });
+
+    // Start/stop ramp, so play buttons no longer click either
+    const float fade = m_crossfadeSeconds.load(std::memory_order_relaxed);
+    const float rampStep = fade > 0.0f ? 1.0f / (fade * m_format.sampleRate()) : 1.0f;
+    const float target = playing ? 1.0f : 0.0f;
+
+    for (int i = 0; i < frames; ++i) {
+        if (m_playGain < target) m_playGain = std::min(target, m_playGain + rampStep);
+        else if (m_playGain > target) m_playGain = std::max(target, m_playGain - rampStep);
+
+        const float gain = 0.5f * m_playGain;
+        float l = left[i] * gain;
+        float r = right[i] * gain;
+        left[i] = (std::isnan(l) || std::isinf(l)) ? 0.0f : l;
+        right[i] = (std::isnan(r) || std::isinf(r)) ? 0.0f : r;
+    }
+}
+
+// --- OVERSAMPLING ---
+// The clock stays in engine-rate samples; only the slots see the finer dt
+void SynthEngine::renderOversampled(float *left, float *right, int frames, double t0, double dt) {
+    const int factor = m_oversampler.factor();
+    const int total = frames * factor;
+    const double osDt = dt / factor;
+
+    for (int done = 0; done < total; done += kBlockFrames) {
+        const int n = std::min(kBlockFrames, total - done);
+        renderSlots(m_osLeft + done, m_osRight + done, n, t0 + done * osDt, osDt);
+    }
+    m_oversampler.process(m_osLeft, m_osRight, total, left, right);
+}
+
+void SynthEngine::writeDeviceSamples(const float *in, char *dst, int count) {
+    switch (m_format.sampleFormat()) {
+    case QAudioFormat::Float:
+        memcpy(dst, in, sizeof(float) * count);
+        break;
+    case QAudioFormat::Int16:
+        convertFloatToInt16(in, reinterpret_cast<qint16*>(dst), count, m_dither);
+        break;
+    case QAudioFormat::Int32:
+        convertFloatToInt32(in, reinterpret_cast<qint32*>(dst), count);
+        break;
+    case QAudioFormat::UInt8:
+        convertFloatToUInt8(in, reinterpret_cast<quint8*>(dst), count, m_dither);
+        break;
+    default:
+        memset(dst, 0, (size_t)count * m_format.bytesPerSample());
+        break;
+    }
+}
+
+// =========================================================
+// OFFLINE RENDERING
+// =========================================================
+static void guardBlock(float *dst, int count, float gain) {
+    for (int i = 0; i < count; ++i) {
+        float sample = dst[i] * gain;
+        dst[i] = (std::isnan(sample) || std::isinf(sample)) ? 0.0f : sample;
+    }
+}
+
+// Renders [startFrame, startFrame + frames) into out. Stereo output is interleaved.
+static void renderRange(AudioSource &source, float *out, qint64 startFrame, qint64 frames, double dt, float gain, bool stereo) {
+    const int block = 4096;
+    std::vector<float> left, right;
+    if (stereo) {
+        left.resize(block);
+        right.resize(block);
+    }
+
+    for (qint64 done = 0; done < frames; done += block) {
+        const int n = (int)std::min<qint64>(block, frames - done);
+        // Each block restarts from an exact frame index so long renders do not drift
+        const double t0 = (double)(startFrame + done) * dt;
+        if (!stereo) {
+            source.render(out + done, n, t0, dt);
+            guardBlock(out + done, n, gain);
+            continue;
+        }
+        source.renderStereo(left.data(), right.data(), n, t0, dt);
+        float *dst = out + done * 2;
+        for (int i = 0; i < n; ++i) {
+            dst[i * 2] = left[i];
+            dst[i * 2 + 1] = right[i];
+        }
+        guardBlock(dst, n * 2, gain);
+    }
+}
+
+std::vector<float> SynthEngine::renderOffline(AudioSource &source, double seconds, const OfflineRenderOptions &options) {
+    if (seconds <= 0.0 || options.sampleRate <= 0.0) return {};
+
+    const qint64 totalFrames = (qint64)std::llround(seconds * options.sampleRate);
+    const double dt = 1.0 / options.sampleRate;
+    const float gain = (float)options.gain;
+    const bool stereo = options.stereo;
+    const int channels = stereo ? 2 : 1;
+    std::vector<float> out((size_t)totalFrames * channels, 0.0f);
+
+    int threads = options.threads > 0 ? options.threads : (int)std::thread::hardware_concurrency();
+    if (!source.isStateless() || threads < 2 || totalFrames < 44100) threads = 1;
+
+    if (threads == 1) {
+        renderRange(source, out.data(), 0, totalFrames, dt, gain, stereo);
+        return out;
+    }
+
+    // Stateless sources: give each core its own contiguous slice of the timeline,
+    // and its own copy of the source where rendering needs scratch memory
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<AudioSource>> copies;
+    const qint64 slice = (totalFrames + threads - 1) / threads;
+    for (int w = 0; w < threads; ++w) {
+        const qint64 start = w * slice;
+        const qint64 count = std::min(slice, totalFrames - start);
+        if (count <= 0) break;
+        copies.push_back(w > 0 ? source.cloneForThread() : nullptr);
+        AudioSource *renderer = copies.back() ? copies.back().get() : &source;
+        workers.emplace_back([renderer, &out, start, count, dt, gain, stereo, channels]() {
+            renderRange(*renderer, out.data() + start * channels, start, count, dt, gain, stereo);
+        });
+    }
+    for (auto &worker : workers) worker.join();
+    return out;
+}
+
+bool SynthEngine::renderToWav(AudioSource &source, double seconds, const QString &fileName, const OfflineRenderOptions &options) {
+    const std::vector<float> samples = renderOffline(source, seconds, options);
+    return writeWav(fileName, samples, options.stereo ? 2 : 1, (int)options.sampleRate);
+}
+
+bool SynthEngine::writeWav(const QString &fileName, const std::vector<float> &samples, int channels, int sampleRate) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) return false;
+
+    const quint32 dataBytes = (quint32)(samples.size() * sizeof(float));
+
+    QDataStream out(&file);
+    out.setByteOrder(QDataStream::LittleEndian);
+
+    out.writeRawData("RIFF", 4);
+    out << (quint32)(36 + dataBytes);
+    out.writeRawData("WAVE", 4);
+    out.writeRawData("fmt ", 4);
+    out << (quint32)16;
+    out << (quint16)3;                 // IEEE float
+    out << (quint16)channels;
+    out << (quint32)sampleRate;
+    out << (quint32)(sampleRate * channels * sizeof(float));
+    out << (quint16)(channels * sizeof(float));
+    out << (quint16)32;
+    out.writeRawData("data", 4);
+    out << dataBytes;
+
+    // Raw little-endian floats. QDataStream's operator<<(float) would write
+    // 64-bit values under its default precision.
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    if (out.writeRawData(reinterpret_cast<const char*>(samples.data()), (int)dataBytes) != (int)dataBytes) {
+        out.setStatus(QDataStream::WriteFailed);
+    }
+#else
+    for (float sample : samples) {
+        quint32 bits;
+        std::memcpy(&bits, &sample, sizeof(bits));
+        bits = qToLittleEndian(bits);
+        if (out.writeRawData(reinterpret_cast<const char*>(&bits), sizeof(bits)) != (int)sizeof(bits)) {
+            out.setStatus(QDataStream::WriteFailed);
+            break;
+        }
+    }
+#endif
+
+    // Short writes (disk full, pulled drive) and failures flushing on close
+    // leave a truncated file; report them rather than a finished render
+    const bool written = out.status() == QDataStream::Ok && file.flush();
+    file.close();
+    if (!written || file.error() != QFileDevice::NoError) {
+        file.remove();
+        return false;
+    }
+    return true;
+}
+
+qint64 SynthEngine::writeData(const char *data, qint64 len) {
+    Q_UNUSED(data);
+    return len;
+}
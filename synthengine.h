@@ -1,46 +1,326 @@
-#ifndef SYNTHENGINE_H
-#define SYNTHENGINE_H
-
-#include <QIODevice>
-#include <QAudioSink>
-#include <QMediaDevices>
-#include <QAudioDevice>
-#include <QMutex>
-#include <cmath>
-#include <functional>
-#include <QString>
-
-class SynthEngine : public QIODevice {
-    Q_OBJECT
-
-public:
-    explicit SynthEngine(QObject *parent = nullptr);
-    ~SynthEngine();
-
-    void start();
-    void stop();
-    void setAudioSource(std::function<double(double)> func);
-
-    bool isSequential() const override;
-    qint64 bytesAvailable() const override;
-
-public slots:                     // <--- Added this block
-    void setExpression(QString code);
-
-protected:
-    qint64 readData(char *data, qint64 maxlen) override;
-    qint64 writeData(const char *data, qint64 len) override;
-
-private:
-    QAudioSink *m_audioSink = nullptr;
-    QAudioFormat m_format;
-    std::function<double(double)> m_oscillator = [](double){ return 0.0; };
-
-    QMutex m_mutex;
-    double m_sampleRate = 44100.0;
-    qint64 m_totalSamples = 0;
-    QString m_currentCode;
-    bool m_isPlaying = false;
-};
-
-#endif // SYNTHENGINE_H
+#ifndef SYNTHENGINE_H
+#define SYNTHENGINE_H
+
+#include <QIODevice>
+#include <QAudioFormat>
+#include <QTimer>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <cmath>
+#include <functional>
+#include <QString>
+#include <memory>
+#include <vector>
+#include "audiosource.h"
+#include "audioconvert.h"
+#include "audiobackend.h"
+#include "previewrecorder.h"
+#include "loopcache.h"
+#include "exprvm.h"
+#include "voicemanager.h"
+#include "spscqueue.h"
+
+// --- ENGINE TELEMETRY ---
+// Snapshot of the counters the audio callback keeps. Render time is binned as a
+// fraction of the callback's real-time budget (frames / sample rate).
+struct EngineStats {
+    static constexpr int kHistogramBins = 8;
+    static constexpr double kBinEdges[kHistogramBins - 1] = { 0.1, 0.25, 0.5, 0.75, 1.0, 1.5, 2.0 };
+    static constexpr int kMixerSlots = 4;
+
+    quint64 callbacks = 0;          // Render periods completed by the render thread
+    quint64 budgetOverruns = 0;     // Periods that took longer than their real-time budget
+    quint64 framesRendered = 0;
+    int sampleRate = 44100;
+    quint64 underruns = 0;          // QAudioSink went idle with UnderrunError
+    quint64 ringUnderruns = 0;      // readData() found the render-ahead ring short
+    bool realtimePriority = false;  // The OS granted the render thread real-time scheduling
+    double cpuLoad = 0.0;           // Smoothed render time / budget, in percent
+    double peakLoad = 0.0;          // Worst single callback since the last reset, in percent
+    int activeVoices = 0;           // Only set while a VoiceManager is playing
+    double perVoiceLoad = 0.0;      // Render time of one voice / budget, in percent
+    double outputLatencyMs = 0.0;   // Audio queued in the render ring and the sink right now
+    double bufferMs = 0.0;          // Sink buffer size for the active latency profile
+    bool recording = false;
+    double recordedSeconds = 0.0;   // Audio already on disk for the running recording
+    qint64 recordDroppedBytes = 0;  // Bytes lost because the disk writer fell behind
+    int activeLayers = 0;           // Mixer slots other than the main preview in use
+    std::array<double, kMixerSlots> slotLoad {}; // Render time of each slot / budget, in percent
+    std::array<int, kMixerSlots> slotDegrade {}; // SynthEngine::GuardStage of each slot
+    std::array<quint64, kHistogramBins> histogram {};
+};
+
+// --- OFFLINE RENDERING ---
+struct OfflineRenderOptions {
+    double sampleRate = 44100.0;
+    bool stereo = false;    // Interleaved L/R output via renderStereo()
+    double gain = 0.5;      // Same level as the live preview
+    int threads = 1;        // 0 = one per core. Only used when the source is stateless
+};
+
+class SynthEngine : public QIODevice {
+    Q_OBJECT
+
+public:
+    // Sink buffer and render period trade-off. Low latency makes knob changes
+    // audible almost immediately but needs a machine that never misses a deadline.
+    enum LatencyProfile { LowLatency, Balanced, Safe };
+
+    // CPU guard: when the render thread nears its real-time budget, the most
+    // expensive slot is rendered at a lower rate, and muted as a last resort.
+    // Reduced rates relax again once there is headroom; a muted slot stays muted
+    // until it gets a new source.
+    enum GuardStage { GuardNormal, GuardHalfRate, GuardQuarterRate, GuardMuted };
+
+    explicit SynthEngine(QObject *parent = nullptr);
+    ~SynthEngine();
+
+    void start();
+    void stop();
+    void setAudioSource(std::function<double(double)> func);
+    // Declared loop: func(t) repeats every loopPeriod seconds. Plays live at once,
+    // then switches to one period rendered on a worker. Returns the ticket that
+    // loopCacheReady() reports, or 0 when the period is too long to cache.
+    quint64 setAudioSource(std::function<double(double)> func, double loopPeriod);
+    // Dual-output source: o1 plays on the left channel, o2 on the right
+    void setStereoSource(StereoFunc func);
+    // Replaces the main preview (mixer slot 0); layers keep playing
+    void setAudioSource(std::unique_ptr<AudioSource> source);
+    // Play a patch polyphonically. Use the returned controller to start and stop notes.
+    std::shared_ptr<VoiceController> setVoiceSource(VoicePatch patch, int maxVoices = 8);
+    // The same with a compiled expression, one ExprVM per voice
+    std::shared_ptr<VoiceController> setVoiceSource(std::shared_ptr<const ExprProgram> program,
+                                                    const ExprInputs &inputs, int maxVoices = 8);
+    // --- MIXER ---
+    // Slot 0 is the main preview that every tab's Play button drives through
+    // setAudioSource(). The other slots are layers that keep playing underneath
+    // it; all of them are summed in one block loop on the render thread.
+    static constexpr int kMixerSlots = EngineStats::kMixerSlots;
+    void setSlotSource(int slot, std::unique_ptr<AudioSource> source);
+    void clearSlot(int slot);
+    void setSlotGain(int slot, double gain);
+    double slotGain(int slot) const;
+    void setSlotMuted(int slot, bool muted);
+    bool isSlotMuted(int slot) const;
+    bool isSlotUsed(int slot) const;
+    // Pin the main preview into a free layer, so the next Play adds to it
+    // instead of replacing it. Returns the layer's slot, or -1 if none is free.
+    int layerMainSource();
+    void clearLayers();
+
+    // Bumped by every setAudioSource(). A tab that keeps its source alive across
+    // slider moves compares this to tell whether another tab has replaced it.
+    quint64 sourceSerial() const { return m_sourceSerial; }
+
+    // Render a source as fast as the CPU allows, without touching the device.
+    // Output starts at t = 0 and is mono unless options.stereo is set.
+    static std::vector<float> renderOffline(AudioSource &source, double seconds,
+                                            const OfflineRenderOptions &options = OfflineRenderOptions());
+    static bool renderToWav(AudioSource &source, double seconds, const QString &fileName,
+                            const OfflineRenderOptions &options = OfflineRenderOptions());
+    // 32-bit float WAV writer shared by every exporter. Samples are interleaved.
+    static bool writeWav(const QString &fileName, const std::vector<float> &samples, int channels, int sampleRate);
+
+    // Swap the output (sound card, null sink, WAV file). The engine starts on
+    // AudioBackend::createFromEnvironment(). Playback state and sources carry over.
+    void setBackend(std::unique_ptr<AudioBackend> backend);
+    AudioBackend *backend() const { return m_backend.get(); }
+
+    // Record exactly what goes to the device, in the device format, until
+    // stopRecording(). Switching backends ends the recording.
+    bool startRecording(const QString &fileName);
+    void stopRecording();
+    bool isRecording() const { return m_recorderOwner != nullptr; }
+    double recordedSeconds() const;
+
+    void setLatencyProfile(LatencyProfile profile);
+    LatencyProfile latencyProfile() const { return m_latencyProfile; }
+    // Queue a parameter change for the playing source. Applied on the render
+    // thread at the next block boundary and smoothed over rampSeconds. GUI thread
+    // only; returns false if the queue is full and the update was dropped.
+    bool setParameter(int slot, double value, double rampSeconds = 0.02);
+
+    // Window over which a replaced source is crossfaded into its successor, and
+    // over which start()/stop() ramp the output. 0 switches on a hard sample edge.
+    void setCrossfadeTime(double seconds);
+    double crossfadeTime() const;
+
+    // Render every source at 1, 2, 4 or 8 times the engine rate and decimate
+    // with a half-band chain, so naive pulses, saws and folders alias far less.
+    // Costs roughly factor times the render time; takes effect at the next period.
+    void setOversampling(int factor);
+    int oversampling() const { return m_oversamplingRequest.load(std::memory_order_relaxed); }
+
+    void setCpuGuardEnabled(bool enabled);
+    bool isCpuGuardEnabled() const { return m_cpuGuardEnabled.load(std::memory_order_relaxed); }
+
+    // Time between a sample leaving readData() and reaching the device, from the sink's fill level
+    double outputLatencyMs() const;
+
+    EngineStats stats() const;
+    void resetStats();
+
+    bool isSequential() const override;
+    qint64 bytesAvailable() const override;
+
+signals:
+    // The main preview now plays from this buffer; scopes can draw from it too
+    void loopCacheReady(quint64 ticket, std::shared_ptr<const LoopBuffer> buffer);
+
+public slots:
+    // Play an Xpressive string exactly as LMMS would evaluate it, through the
+    // bytecode VM. Replaces the main preview; returns false (and the parser's
+    // message) if the string doesn't parse.
+    bool setExpression(const QString &code, QString *error = nullptr);
+    // Lower expressions to x86-64 machine code instead of interpreting them.
+    // Ignored (interpreted as before) on CPUs and platforms the JIT can't target.
+    void setNativeExpressions(bool enabled) { m_nativeExpressions = enabled; }
+    bool nativeExpressions() const { return m_nativeExpressions; }
+
+protected:
+    qint64 readData(char *data, qint64 maxlen) override;
+    qint64 writeData(const char *data, qint64 len) override;
+
+private slots:
+    void reclaimRetiredSources();
+    void handleBackendUnderrun();
+    void adoptLoopCache(quint64 ticket, std::shared_ptr<const LoopBuffer> buffer);
+
+private:
+    // Frames rendered per source call; readData() walks the device buffer in these steps
+    static constexpr int kBlockFrames = 512;
+    static constexpr int kInterleavedSamples = kBlockFrames * 8;
+
+    void openBackend();
+    void closeBackend();
+    void startRenderThread();
+    void stopRenderThread();
+    void renderThreadMain();
+    void renderPeriod(char *data, int frames);
+    struct MixerSlot;
+    void updateSlots(bool playing);
+    void adoptSource(MixerSlot &slot, AudioSource *incoming, bool playing);
+    void mixCrossfade(MixerSlot &slot, float *left, float *right, int frames);
+    void renderSlots(float *left, float *right, int frames, double t0, double dt);
+    void drainParamCommands(double sampleRate);
+    void renderReduced(AudioSource *source, float *left, float *right, int frames, double t0, double dt,
+                       int factor, float *prev);
+    void updateCpuGuard(int frames);
+    void renderDeviceBlock(float *left, float *right, int frames, bool playing);
+    void renderOversampled(float *left, float *right, int frames, double t0, double dt);
+    double renderRate() const { return m_sampleRate * m_oversampler.factor(); }
+    void writeDeviceSamples(const float *in, char *dst, int count);
+    void tapRecorder(const char *data, qint64 len);
+
+    std::unique_ptr<AudioBackend> m_backend;
+    QAudioFormat m_format;
+    bool m_freewheel = false;       // Backend pulls as fast as it can; render inside readData()
+    LatencyProfile m_latencyProfile = Balanced;
+    int m_periodFrames = 256;       // Render block size; only changed while the sink is stopped
+
+    // Synthesis runs on m_renderThread, which keeps m_ring a few periods ahead
+    // of the device. readData() is reduced to a copy out of the ring.
+    std::thread m_renderThread;
+    std::atomic<bool> m_renderRunning { false };
+    std::mutex m_renderWakeMutex;   // Only ever locked by the render thread
+    std::condition_variable m_renderWake;
+    SpscByteRing m_ring;
+    size_t m_ringTargetBytes = 0;
+    std::vector<char> m_periodBuffer;
+
+    // Source hand-off: the GUI publishes into a slot's pending pointer, the render
+    // thread adopts it at the start of a period and pushes the source it replaced
+    // onto m_retiredSources. Deleting happens on the GUI thread in
+    // reclaimRetiredSources(), so rendering never locks and never frees a captured buffer.
+    struct MixerSlot {
+        std::atomic<AudioSource*> pending { nullptr };
+        std::atomic<bool> clearRequest { false }; // Fade the slot out; handled before pending
+        std::atomic<float> gain { 1.0f };
+        std::atomic<bool> muted { false };
+        std::atomic<float> load { 0.0f };         // Smoothed render cost, percent of budget
+
+        // Render thread only
+        AudioSource *active = nullptr;
+        AudioSource *fading = nullptr;            // Outgoing source while a crossfade runs
+        int fadeLength = 1;
+        int fadeRemaining = 0;
+        float appliedGain = 0.0f;                 // Ramps towards gain (or 0 when muted)
+        std::atomic<int> degrade { GuardNormal }; // Written by the CPU guard, read by stats()
+        float prev[2] = { 0.0f, 0.0f };           // Last reduced-rate sample, for interpolation
+        float fadePrev[2] = { 0.0f, 0.0f };
+    };
+    std::array<MixerSlot, kMixerSlots> m_slots;
+    std::array<bool, kMixerSlots> m_slotUsed {};  // GUI thread's view of which slots hold a source
+    std::atomic<int> m_layerRequest { 0 };         // Move slot 0 into this slot; 0 = none
+    SpscQueue<ParamCommand, 256> m_paramCommands; // GUI -> render thread, for slot 0
+    // Render thread only: latest command per parameter that arrived while a new
+    // slot 0 source was pending, replayed to it when it is adopted
+    std::array<ParamCommand, ParameterBank::kMaxParams> m_heldParams {};
+    std::uint32_t m_heldParamMask = 0;
+    SpscQueue<AudioSource*, 64> m_retiredSources;
+    QTimer *m_reclaimTimer = nullptr;
+    std::shared_ptr<VoiceController> m_voiceController; // GUI thread only, for stats()
+    quint64 m_sourceSerial = 0;                         // GUI thread only
+    LoopRenderer *m_loopRenderer = nullptr;
+    quint64 m_loopTicket = 0;       // Outstanding loop render for slot 0, 0 = none
+    quint64 m_loopSerial = 0;       // m_sourceSerial the loop render belongs to
+    float m_leftBuffer[kBlockFrames];
+    float m_rightBuffer[kBlockFrames];
+    static_assert(StreamResampler::kInputBlock <= kBlockFrames, "slot buffers must hold one resampler block");
+    float m_slotLeft[kBlockFrames];     // One slot's output before it is mixed in
+    float m_slotRight[kBlockFrames];
+    float m_fadeLeft[kBlockFrames];
+    float m_fadeRight[kBlockFrames];
+    float m_playGain = 0.0f;            // Start/stop ramp, render thread only
+    static_assert(Oversampler::kMaxFactor * kBlockFrames <= HalfBandDecimator::kMaxInput,
+                  "one oversampled block must fit the decimator");
+    float m_osLeft[kBlockFrames * Oversampler::kMaxFactor];  // One block at the oversampled rate
+    float m_osRight[kBlockFrames * Oversampler::kMaxFactor];
+    Oversampler m_oversampler;          // Render thread only
+    std::atomic<int> m_oversamplingRequest { 1 };
+
+    // CPU guard bookkeeping, render thread only
+    static constexpr float kGuardHighLoad = 0.8f;    // Smoothed load that counts as "close to the budget"
+    static constexpr float kGuardLowLoad = 0.4f;     // ... and as comfortable headroom
+    static constexpr double kGuardEscalateSeconds = 0.05;
+    static constexpr double kGuardRelaxSeconds = 3.0;
+    std::atomic<bool> m_cpuGuardEnabled { true };
+    double m_guardOverSeconds = 0.0;
+    double m_guardUnderSeconds = 0.0;
+    double m_guardHoldoff = 0.0;
+    std::atomic<float> m_crossfadeSeconds { 0.02f };
+    float m_interleaved[kInterleavedSamples];
+    StreamResampler m_resampler;    // Engine rate -> device rate
+    DitherState m_dither;
+
+    double m_sampleRate = 44100.0;  // Engine (render) rate; the device may run at another
+    qint64 m_totalSamples = 0;   // Render thread only
+    std::atomic<bool> m_resetClock { false };
+    std::atomic<bool> m_isPlaying { false };
+
+    // Recorder tap in readData(). m_tapBusy brackets the audio thread's use of
+    // m_recorder, so stopRecording() knows when it may free it.
+    std::unique_ptr<PreviewRecorder> m_recorderOwner; // GUI thread only
+    std::atomic<PreviewRecorder*> m_recorder { nullptr };
+    std::atomic<bool> m_tapBusy { false };
+
+    // Telemetry, written by the render thread (ring underruns by the audio thread,
+    // backend underruns by the GUI thread) and read lock-free by stats()
+    void recordCallback(qint64 frames, double seconds);
+    std::atomic<quint64> m_statCallbacks { 0 };
+    std::atomic<quint64> m_statOverruns { 0 };
+    std::atomic<quint64> m_statFrames { 0 };
+    std::atomic<quint64> m_statUnderruns { 0 };
+    std::atomic<quint64> m_statRingUnderruns { 0 };
+    std::atomic<bool> m_statRealtime { false };
+    std::atomic<float> m_statLoad { 0.0f };
+    std::atomic<float> m_statPeakLoad { 0.0f };
+    std::array<std::atomic<quint64>, EngineStats::kHistogramBins> m_statHistogram {};
+    QString m_currentCode;
+    bool m_nativeExpressions = false;
+};
+
+#endif // SYNTHENGINE_H
@@ -0,0 +1,33 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <cstdio>
+#include <string>
+
+// Minimal assertions for the test executables: a failed CHECK prints where and
+// carries on, and main() returns checkResult() so ctest sees the failure.
+
+inline int &checkFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+inline void checkFailed(const char *file, int line, const std::string &what) {
+    std::printf("%s:%d: FAILED %s\n", file, line, what.c_str());
+    ++checkFailures();
+}
+
+#define CHECK(cond) \
+    do { if (!(cond)) checkFailed(__FILE__, __LINE__, #cond); } while (0)
+
+// With the failing case named, for checks inside loops over inputs
+#define CHECK_CASE(cond, label) \
+    do { if (!(cond)) checkFailed(__FILE__, __LINE__, std::string(#cond) + "  [" + std::string(label) + "]"); } while (0)
+
+inline int checkResult() {
+    if (checkFailures() == 0) std::printf("all checks passed\n");
+    else std::printf("%d check(s) failed\n", checkFailures());
+    return checkFailures() == 0 ? 0 : 1;
+}
+
+#endif // CHECK_H
@@ -0,0 +1,70 @@
+#ifndef RANDOMEXPRESSION_H
+#define RANDOMEXPRESSION_H
+
+#include <random>
+#include <string>
+
+// Random Xpressive sources for differential tests. Conditions mostly follow
+// fast oscillators, so most 128-sample blocks have lanes that disagree and
+// both arms of a ternary run; the rest are time windows, where whole blocks
+// agree. Seeded, so a failure names a reproducible case.
+
+class RandomExpression {
+public:
+    explicit RandomExpression(unsigned seed) : m_rng(seed) {}
+
+    bool stateful = true;       // integrate() and last()
+    bool lastRuntime = false;   // last() with an offset computed per sample
+
+    std::string next(int depth = 5) { return node(depth); }
+
+private:
+    int pick(int count) { return (int)(m_rng() % (unsigned)count); }
+
+    std::string leaf() {
+        static const char *const leaves[] = { "t", "f", "A1", "0.5", "2", "-1.25", "0", "(t * 7)", "v", "1e-3" };
+        return leaves[pick(10)];
+    }
+
+    std::string condition(int depth) {
+        static const char *const conditions[] = {
+            "sinew(t * 331) > 0", "saww(t * 97) < 0.25", "t < 0.05", "t >= 0.2", "squarew(t * 53) == 1"
+        };
+        if (depth > 1 && pick(3) == 0) return "(" + node(depth - 1) + ") > 0";
+        return conditions[pick(5)];
+    }
+
+    std::string node(int depth) {
+        if (depth <= 0) return leaf();
+        static const char *const binary[] = { " + ", " - ", " * ", " / ", " < ", " <= ", " >= ", " != ", " & ", " | " };
+        static const char *const unary[] = { "sinew", "saww", "squarew", "trianglew", "sin", "cos", "abs", "floor", "sqrt", "exp", "sgn", "tanh" };
+        const int choice = pick(stateful ? 11 : 9);
+        switch (choice) {
+        case 0: case 1: case 2:
+            return "(" + node(depth - 1) + binary[pick(10)] + node(depth - 1) + ")";
+        case 3:
+            return std::string(unary[pick(12)]) + "(" + node(depth - 1) + ")";
+        case 4:
+            return "(" + condition(depth) + " ? " + node(depth - 1) + " : " + node(depth - 1) + ")";
+        case 5:
+            return std::string(pick(2) ? "min(" : "max(") + node(depth - 1) + ", " + node(depth - 1) + ")";
+        case 6:
+            return "clamp(-1, " + node(depth - 1) + ", 1)";
+        case 7:
+            return "mod(" + node(depth - 1) + ", 0.7)";
+        case 8:
+            return pick(2) ? "-" + node(depth - 1) : "not(" + node(depth - 1) + ")";
+        case 9:
+            return "integrate(" + node(depth - 1) + ")";
+        default: {
+            static const char *const offsets[] = { "1", "3", "100", "200", "129" };
+            if (lastRuntime && pick(2)) return "last(1 + floor(trianglew(t * 3) * 150))";
+            return std::string("last(") + offsets[pick(5)] + ")";
+        }
+        }
+    }
+
+    std::mt19937 m_rng;
+};
+
+#endif // RANDOMEXPRESSION_H
@@ -0,0 +1,161 @@
+#ifndef SCALARREFERENCE_H
+#define SCALARREFERENCE_H
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include "exprtree.h"
+#include "exprvm.h"
+
+// ==============================================================================
+// SCALAR REFERENCE EVALUATOR
+// ==============================================================================
+// The obvious way to run a tree: one sample at a time, recursing, with each
+// ternary evaluating only the arm it selects. The VM's results are checked
+// against this. It follows the VM's documented model where that is a choice:
+//  - a var value, or a subtree used twice, is evaluated once per sample,
+//    ahead of the rest, whichever arm it is read from (or none: exprtk runs
+//    every var statement)
+//  - each integrate() call site keeps its own accumulator, which advances
+//    only on the samples where it is evaluated
+//  - t is the block start plus the offset into the block, so it rounds the
+//    same way for a given block length
+// Only for test-sized trees: evaluation recurses.
+
+class ScalarReference {
+public:
+    ScalarReference(const ExprTree &tree, int blockLength) : m_tree(tree), m_blockLength(blockLength) {
+        const std::size_t count = tree.nodes.size();
+        m_uses.assign(count, 0);
+        m_reachable.assign(count, 0);
+        m_reachable[tree.root] = 1;
+        m_uses[tree.root] = 1;
+        m_bound.assign(count, 0);
+        for (const ExprBinding &binding : tree.bindings) {
+            if (binding.node >= 0) m_bound[binding.node] = 1;
+        }
+        for (std::size_t i = count; i-- > 0;) {
+            if (!m_reachable[i]) continue;
+            const ExprNode &node = tree.nodes[i];
+            for (std::int32_t child : { node.a, node.b, node.c }) {
+                if (child < 0) continue;
+                m_reachable[child] = 1;
+                ++m_uses[child];
+            }
+        }
+        m_accumulators.assign(count, 0.0);
+        m_values.assign(count, 0.0);
+        m_done.assign(count, 0);
+        m_history.assign(ExprProgram::kMaxHistory, 0.0);
+    }
+
+    ExprInputs inputs;
+
+    // Continues from the previous call, like ExprVM::render()
+    std::vector<float> render(int frames, double t0, double dt) {
+        std::vector<float> out((std::size_t)frames);
+        for (int s = 0; s < frames; ++s) {
+            const int blockStart = s - s % m_blockLength;
+            m_time = (t0 + blockStart * dt) + (s - blockStart) * dt;
+            m_dt = dt;
+            std::fill(m_done.begin(), m_done.end(), 0);
+            for (std::size_t i = 0; i < m_tree.nodes.size(); ++i) {
+                if (m_reachable[i] && (m_uses[i] > 1 || m_bound[i])) evaluate((std::int32_t)i);
+            }
+            const double value = evaluate(m_tree.root);
+            out[(std::size_t)s] = (float)value;
+            m_history[m_written++ % m_history.size()] = value;
+        }
+        return out;
+    }
+
+private:
+    double input(int index) const {
+        switch (index) {
+        case ExprNode::Time:        return m_time;
+        case ExprNode::Frequency:   return inputs.frequency;
+        case ExprNode::SampleRate:  return 1.0 / m_dt;
+        case ExprNode::Tempo:       return inputs.tempo;
+        case ExprNode::Velocity:    return inputs.velocity;
+        case ExprNode::Key:         return inputs.key;
+        case ExprNode::Release:     return inputs.release;
+        case ExprNode::ReleaseTime: return inputs.releaseTime;
+        default:                    return inputs.knobs[index - ExprNode::Knob1];
+        }
+    }
+
+    static double truth(bool value) { return value ? 1.0 : 0.0; }
+
+    double evaluate(std::int32_t index) {
+        if (m_done[index]) return m_values[index];
+        const ExprNode &node = m_tree.nodes[index];
+        double result = 0.0;
+        switch (node.op) {
+        case ExprNode::Const:    result = node.value; break;
+        case ExprNode::Variable: result = input(node.index); break;
+        case ExprNode::Neg:      result = -evaluate(node.a); break;
+        case ExprNode::Not:      result = truth(evaluate(node.a) == 0.0); break;
+        case ExprNode::Select:   result = evaluate(node.a) != 0.0 ? evaluate(node.b) : evaluate(node.c); break;
+        case ExprNode::Call:     result = call(index, node); break;
+        default: {
+            const double x = evaluate(node.a);
+            const double y = evaluate(node.b);
+            switch (node.op) {
+            case ExprNode::Add: result = x + y; break;
+            case ExprNode::Sub: result = x - y; break;
+            case ExprNode::Mul: result = x * y; break;
+            case ExprNode::Div: result = x / y; break;
+            case ExprNode::Mod: result = std::fmod(x, y); break;
+            case ExprNode::Pow: result = std::pow(x, y); break;
+            case ExprNode::Lt:  result = truth(x < y); break;
+            case ExprNode::Le:  result = truth(x <= y); break;
+            case ExprNode::Gt:  result = truth(x > y); break;
+            case ExprNode::Ge:  result = truth(x >= y); break;
+            case ExprNode::Eq:  result = truth(x == y); break;
+            case ExprNode::Ne:  result = truth(x != y); break;
+            case ExprNode::And: result = truth(x != 0.0 && y != 0.0); break;
+            case ExprNode::Or:  result = truth(x != 0.0 || y != 0.0); break;
+            default: break;
+            }
+            break;
+        }
+        }
+        m_done[index] = 1;
+        m_values[index] = result;
+        return result;
+    }
+
+    double call(std::int32_t index, const ExprNode &node) {
+        const ExprNode::Func func = (ExprNode::Func)node.index;
+        if (func == ExprNode::Integrate) {
+            const double phase = m_accumulators[index];
+            m_accumulators[index] += evaluate(node.a) * m_dt;
+            return phase;
+        }
+        if (func == ExprNode::Last) {
+            const double offset = evaluate(node.a);
+            const std::size_t length = m_history.size();
+            const std::size_t back = !(offset >= 1.0) ? 1 : (offset >= (double)length ? length : (std::size_t)offset);
+            return m_history[(m_written + length - back) % length];
+        }
+        const double a = evaluate(node.a);
+        const double b = node.b >= 0 ? evaluate(node.b) : 0.0;
+        const double c = node.c >= 0 ? evaluate(node.c) : 0.0;
+        return ExprVM::evaluateFunction(func, a, b, c);
+    }
+
+    const ExprTree &m_tree;
+    int m_blockLength;
+    std::vector<int> m_uses;
+    std::vector<char> m_reachable;
+    std::vector<char> m_bound;
+    std::vector<char> m_done;
+    std::vector<double> m_values;
+    std::vector<double> m_accumulators;
+    std::vector<double> m_history;
+    std::size_t m_written = 0;
+    double m_time = 0.0;
+    double m_dt = 0.0;
+};
+
+#endif // SCALARREFERENCE_H
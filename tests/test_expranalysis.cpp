@@ -0,0 +1,91 @@
+#include "check.h"
+#include "expranalysis.h"
+#include <string>
+#include <vector>
+
+// --- HELPERS ---
+static ExprAnalysis analyze(const std::string &source) {
+    ExprTree tree;
+    ExprParseError error;
+    CHECK_CASE(ExprTree::parse(source, tree, &error), source + ": " + error.message);
+    return analyzeTree(tree, source.size());
+}
+
+// --- COUNTS ---
+static void testCounts() {
+    const ExprAnalysis wave = analyze("sinew(t * 440)");
+    CHECK(wave.bytes == 14);
+    CHECK(wave.nodes == 4);
+    CHECK(wave.depth == 3);
+    CHECK(wave.calls[ExprNode::Sinew] == 1);
+    CHECK(wave.transcendentals == 1);
+    CHECK(wave.powers == 0);
+    CHECK(wave.stateful == 0);
+    CHECK(wave.cost == 21.0);
+
+    const ExprAnalysis powers = analyze("t ^ 2 + pow(t, 3) + exp(t)");
+    CHECK(powers.powers == 2);
+    CHECK(powers.transcendentals == 3);
+
+    const ExprAnalysis state = analyze("integrate(f) + last(3) + integrate(2 * f)");
+    CHECK(state.stateful == 3);
+    CHECK(state.calls[ExprNode::Integrate] == 2);
+    CHECK(state.calls[ExprNode::Last] == 1);
+    CHECK(state.transcendentals == 0);
+}
+
+// Only the dearer arm of a ternary counts; a var body counts once however
+// often it is read, and each read is one level deep
+static void testCost() {
+    CHECK(analyze("t < 0.5 ? sinew(t) : t * 2").cost == 22.0);
+    CHECK(analyze("t < 0.5 ? t * 2 : sinew(t)").cost == 22.0);
+
+    const ExprAnalysis shared = analyze("var x := sinew(t * 440); x + x + x");
+    CHECK(shared.cost == 23.0);
+    CHECK(shared.depth == 3);
+    CHECK(shared.calls[ExprNode::Sinew] == 1);
+
+    // Pasted in three times, it costs three times
+    const ExprAnalysis pasted = analyze("sinew(t * 440) + sinew(t * 440) + sinew(t * 440)");
+    CHECK(pasted.cost == 65.0);
+    CHECK(pasted.depth == 5);
+    CHECK(pasted.calls[ExprNode::Sinew] == 3);
+
+    // An unused var is still declared, so still run
+    CHECK(analyze("var unused := exp(t); t").cost == 20.0);
+}
+
+// Non-recursive, so nesting far past the limit is measured rather than fatal
+static void testDeepNesting() {
+    const int levels = 100000;
+    const std::string source = std::string(levels, '(') + "t" + std::string(levels, ')') + std::string(" + 1");
+    const std::string chain = std::string(levels, '-') + "t";
+    CHECK(analyze(source).depth == 2);
+    CHECK(analyze(chain).depth == levels + 1);
+}
+
+// --- LIMITS ---
+static void testLimits() {
+    const ExprAnalysis wave = analyze("sinew(t * 440)");
+    CHECK(exceededLimits(wave, ExprAnalysisLimits()).empty());
+
+    ExprAnalysisLimits tight;
+    tight.depth = 2;
+    tight.cost = 10.0;
+    tight.bytes = 1024;
+    ExprAnalysis large = wave;
+    large.bytes = 2048;
+    const std::vector<std::string> exceeded = exceededLimits(large, tight);
+    CHECK(exceeded.size() == 3);
+    CHECK(exceeded.size() == 3 && exceeded[0] == "size 2.0 KB > 1.0 KB");
+    CHECK(exceeded.size() == 3 && exceeded[1] == "depth 3 > 2");
+    CHECK(exceeded.size() == 3 && exceeded[2] == "cost 21 > 10 per sample");
+}
+
+int main() {
+    testCounts();
+    testCost();
+    testDeepNesting();
+    testLimits();
+    return checkResult();
+}
@@ -0,0 +1,125 @@
+#include "check.h"
+#include "exprcache.h"
+#include "exprjit.h"
+#include <string>
+
+// --- HELPERS ---
+// Every text lands in the same slot
+static std::uint64_t collide(const std::string &) {
+    return 7;
+}
+
+// A lookup that misses compiles again; one that hits doesn't
+static bool cached(ExprCache &cache, const std::string &source) {
+    const std::size_t misses = cache.misses();
+    cache.lookup(source);
+    return cache.misses() == misses;
+}
+
+// --- HITS ---
+static void testHits() {
+    ExprCache cache;
+    const std::shared_ptr<const ExprCache::Entry> first = cache.lookup("sinew(t * 440)");
+    CHECK(cache.hits() == 0 && cache.misses() == 1);
+    CHECK(first->program != nullptr);
+    CHECK(first->tree.isValid());
+    CHECK(first->analysis.nodes == 4);
+
+    // The same entry back, not a copy
+    CHECK(cache.lookup("sinew(t * 440)") == first);
+    CHECK(cache.hits() == 1 && cache.misses() == 1);
+
+    // Same sound, different text: a different entry
+    CHECK(cache.lookup("sinew(t*440)") != first);
+    CHECK(cache.misses() == 2);
+
+    cache.clear();
+    CHECK(!cached(cache, "sinew(t * 440)"));
+    CHECK(first->program != nullptr);
+}
+
+// A text that doesn't parse is remembered with its error
+static void testErrors() {
+    ExprCache cache;
+    std::string error;
+    CHECK(cache.program("sinew(t", &error) == nullptr);
+    CHECK_CASE(error.compare(0, 15, "Parse error at ") == 0, error);
+    CHECK(!cache.lookup("sinew(t")->tree.isValid());
+    CHECK(cache.hits() == 1 && cache.misses() == 1);
+    CHECK(cache.lookup("sinew(t")->analysis.bytes == 7);
+}
+
+// --- EVICTION ---
+static void testEvictionByCount() {
+    ExprCache cache(3);
+    cache.lookup("1");
+    cache.lookup("2");
+    cache.lookup("3");
+    cache.lookup("1");          // Now the most recent
+    cache.lookup("4");          // Pushes out 2, the least recent
+    CHECK(cached(cache, "1"));
+    CHECK(cached(cache, "3"));
+    CHECK(cached(cache, "4"));
+    CHECK(!cached(cache, "2"));
+}
+
+static void testEvictionByBytes() {
+    // Room for a few small entries
+    ExprCache cache(32, 64 * 1024);
+    const std::shared_ptr<const ExprCache::Entry> small = cache.lookup("t");
+    cache.lookup("t + 1");
+    CHECK(cached(cache, "t"));
+    CHECK(cached(cache, "t + 1"));
+
+    // A long PCM-like string is over the budget on its own: everything else
+    // goes, but the newest entry always stays
+    std::string large = "0";
+    for (int i = 0; i < 20000; ++i) large += " + " + std::to_string(i % 10);
+    cache.lookup(large);
+    CHECK(cached(cache, large));
+    CHECK(!cached(cache, "t + 1"));
+
+    // Evicted entries stay usable by whoever holds them
+    CHECK(small->program != nullptr && small->source == "t");
+}
+
+// --- COLLISIONS ---
+// Texts with the same hash are told apart by their full text
+static void testCollisions() {
+    ExprCache cache(32, std::size_t(256) << 20, &collide);
+    const std::shared_ptr<const ExprCache::Entry> a = cache.lookup("t");
+    const std::shared_ptr<const ExprCache::Entry> b = cache.lookup("t + 1");
+    CHECK(cache.misses() == 2 && cache.hits() == 0);
+    CHECK(a->source == "t" && b->source == "t + 1");
+    CHECK(a->analysis.nodes == 1 && b->analysis.nodes == 3);
+
+    // The slot holds the latest; the other text compiles again
+    CHECK(cached(cache, "t + 1"));
+    CHECK(!cached(cache, "t"));
+    CHECK(cache.lookup("t")->source == "t");
+    CHECK(cache.lookup("t + 1")->source == "t + 1");
+}
+
+// --- NATIVE ---
+static void testNative() {
+    ExprCache cache;
+    const std::shared_ptr<const ExprProgram> bytecode = cache.program("sinew(t * 440)");
+    const std::shared_ptr<const ExprProgram> native = cache.program("sinew(t * 440)", nullptr, true);
+    CHECK(bytecode != nullptr && native != nullptr);
+    CHECK(cache.program("sinew(t * 440)", nullptr, true) == native);
+    CHECK(!bytecode->nativeCode());
+    // Lowered where the host can run it, the bytecode itself where it can't
+    if (ExprNativeCode::hostLevel() >= ExprNativeCode::Sse2) CHECK(native->nativeCode() != nullptr);
+    else CHECK(native == bytecode);
+    CHECK(cache.misses() == 1);
+}
+
+int main() {
+    testHits();
+    testErrors();
+    testEvictionByCount();
+    testEvictionByBytes();
+    testCollisions();
+    testNative();
+    return checkResult();
+}
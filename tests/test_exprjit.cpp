@@ -0,0 +1,137 @@
+#include "check.h"
+#include "randomexpression.h"
+#include "exprjit.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Native code has to produce exactly the interpreter's samples, at every level
+// the host can run. Skipped (and reported) where there is no native back end.
+
+// --- HELPERS ---
+static const double kDt = 1.0 / 44100.0;
+
+static bool sameBits(float a, float b) {
+    if (std::isnan(a) && std::isnan(b)) return true;
+    std::uint32_t x, y;
+    std::memcpy(&x, &a, sizeof x);
+    std::memcpy(&y, &b, sizeof y);
+    return x == y;
+}
+
+static std::vector<float> render(const std::shared_ptr<const ExprProgram> &program, int frames, int chunk) {
+    ExprVM vm(program);
+    ExprInputs inputs;
+    inputs.frequency = 330.0;
+    inputs.knobs[0] = 0.3;
+    vm.setInputs(inputs);
+    std::vector<float> out((std::size_t)frames);
+    for (int done = 0; done < frames; done += chunk) {
+        const int n = std::min(chunk, frames - done);
+        vm.render(out.data() + done, n, -0.01 + done * kDt, kDt);
+    }
+    return out;
+}
+
+static std::vector<ExprNativeCode::Level> levels() {
+    std::vector<ExprNativeCode::Level> result;
+    const ExprNativeCode::Level host = ExprNativeCode::hostLevel();
+    if (host >= ExprNativeCode::Sse2) result.push_back(ExprNativeCode::Sse2);
+    if (host >= ExprNativeCode::Avx2) result.push_back(ExprNativeCode::Avx2);
+    return result;
+}
+
+static void checkNative(const std::string &source, int frames = 4000) {
+    std::string error;
+    const std::shared_ptr<const ExprProgram> program = ExprProgram::fromSource(source, &error);
+    CHECK_CASE(program != nullptr, source + ": " + error);
+    if (!program) return;
+    const std::vector<float> expected = render(program, frames, 1000);
+
+    for (ExprNativeCode::Level level : levels()) {
+        const std::string label = source + " at " + ExprNativeCode::levelName(level);
+        const std::shared_ptr<const ExprProgram> lowered = ExprNativeCode::lower(*program, level);
+        CHECK_CASE(lowered && lowered->nativeCode(), label);
+        if (!lowered || !lowered->nativeCode()) continue;
+        CHECK_CASE(lowered->nativeCode()->level() == level, label);
+
+        const std::vector<float> actual = render(lowered, frames, 1000);
+        std::size_t at = 0;
+        while (at < actual.size() && sameBits(actual[at], expected[at])) ++at;
+        CHECK_CASE(at == actual.size(), label + " sample " + std::to_string(at));
+    }
+}
+
+// --- CASES ---
+static void testOperators() {
+    const char *const sources[] = {
+        "sinew(t * 440)", "sinew(integrate(f))", "t < 0.25 ? 1 : -1", "(t > 0.1 & t < 0.2) * saww(t * 100) + 2 * t",
+        "clamp(-0.5, 2 * sinew(t * 3), 0.5)", "1 - t", "3 / (t + 1)", "0.2 < t", "-t", "0.5", "t",
+        "mod(t, 0.1) * 10 + 2 ^ t", "semitone(12) * trianglew(t * 7) * squarew(t * 3)",
+        "!(t > 0.1)", "not(t > 0.1) or t < 0.05", "t >= 0.1", "t <= 0.1", "t == 0.1", "t != 0.1",
+        "t >= 0.2 ? t : -t", "0.2 >= t", "0.2 <= t", "0.2 == t", "0.2 != t", "0.2 > t",
+        "abs(sinew(t))", "sqrt(t)", "floor(t * 10) + ceil(t * 7) + trunc(-t * 5) + round(t * 3)",
+        "min(t, 0.1) + max(t, sinew(t))", "min(t / 0, 0.1)", "max(0 / 0, t)", "clamp(A1, t, 0.4)", "clamp(0 / 0, t, 0.4)",
+        "sgn(t - 0.1)", "atan2(t, 0.3) + randsv(t * 100, 3) + randv(t * 1000)", "log(t) + exp(t) + tan(t)",
+        "2 / t + t / 2 - (2 - t)", "var x := t * 3; var y := x * x; y - x + y * x",
+        "t > 0.1 ? (t < 0.2 ? 1 : 2) : (t > -0.05 ? 3 : 4)", "t * f / srate * key / v + tempo",
+        "sinew(t * 331) > 0 ? integrate(f) : -integrate(2 * f)",
+    };
+    for (const char *source : sources) checkNative(source);
+}
+
+// A binary-search PCM tree, the shape the native code exists for
+static void testPcmTree() {
+    const int count = 4000;
+    struct Range { int start, end; };
+    // Pairs merged level by level; the same tree the generators write
+    std::vector<std::string> level;
+    for (int i = 0; i < count; ++i) level.push_back(std::to_string(std::sin(i * 0.01)));
+    std::vector<Range> ranges;
+    for (int i = 0; i < count; ++i) ranges.push_back({ i, i });
+    while (level.size() > 1) {
+        std::vector<std::string> next;
+        std::vector<Range> nextRanges;
+        for (std::size_t i = 0; i + 1 < level.size(); i += 2) {
+            next.push_back("((s <= " + std::to_string(ranges[i].end) + ") ? (" + level[i] + ") : (" + level[i + 1] + "))");
+            nextRanges.push_back({ ranges[i].start, ranges[i + 1].end });
+        }
+        if (level.size() % 2) {
+            next.push_back(level.back());
+            nextRanges.push_back(ranges.back());
+        }
+        level.swap(next);
+        ranges.swap(nextRanges);
+    }
+    checkNative("var s := floor((t + 0.01) * 44100);\n" + level[0], 6000);
+}
+
+// last(1) limits blocks to one sample, so the vector loops must stop after
+// one lane group rather than run over all kLanes
+static void testShortBlocks() {
+    checkNative("0.5 * last(1) + 0.5 * sinew(t * 440)");
+    checkNative("last(3) * 0.9 + (sinew(t * 331) > 0 ? t : -t)");
+    checkNative("0.7 * last(1 + floor(trianglew(t * 3) * 150)) + saww(t * 110)");
+}
+
+static void testRandom() {
+    RandomExpression random(977);
+    random.lastRuntime = true;
+    for (int i = 0; i < 300; ++i) checkNative(random.next(5), 1500);
+}
+
+int main() {
+    if (levels().empty()) {
+        std::printf("no native back end on this host (%s); nothing to compare\n",
+                    ExprNativeCode::levelName(ExprNativeCode::hostLevel()));
+        return checkResult();
+    }
+    for (ExprNativeCode::Level level : levels()) std::printf("checking %s\n", ExprNativeCode::levelName(level));
+    testOperators();
+    testShortBlocks();
+    testPcmTree();
+    testRandom();
+    return checkResult();
+}
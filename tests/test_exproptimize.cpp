@@ -0,0 +1,256 @@
+#include "check.h"
+#include "randomexpression.h"
+#include "scalarreference.h"
+#include "exproptimize.h"
+#include "exprvm.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+// --- HELPERS ---
+static const double kDt = 1.0 / 8000.0;
+
+// Samples from t = 0 to duration (2 s when open-ended), as LMMS would play them
+static std::vector<float> render(const std::shared_ptr<const ExprProgram> &program, double duration) {
+    if (!program) return {};
+    ExprVM vm(program);
+    ExprInputs inputs;
+    inputs.frequency = 220.0;
+    inputs.knobs[0] = 0.3;
+    vm.setInputs(inputs);
+    std::vector<float> out((std::size_t)((duration > 0.0 ? duration : 2.0) / kDt) + 1);
+    vm.render(out.data(), (int)out.size(), 0.0, kDt);
+    return out;
+}
+
+static std::vector<float> render(const std::string &source, double duration) {
+    return render(ExprProgram::fromSource(source), duration);
+}
+
+// Algebra may move the last bit of a double; nothing more is allowed
+static bool closeEnough(float a, float b) {
+    if (a == b || (std::isnan(a) && std::isnan(b))) return true;
+    return std::fabs(a - b) <= 1e-6f * std::max(1.0f, std::fabs(a));
+}
+
+// The optimised text renders what the original does within the sound
+static std::string checkPreserved(const std::string &source, const ExprOptimizeOptions &options) {
+    const std::string optimised = optimizeSource(source, options);
+    const std::vector<float> before = render(source, options.duration);
+    const std::vector<float> after = render(optimised, options.duration);
+    CHECK_CASE(!before.empty(), "doesn't compile: " + source);
+    CHECK_CASE(after.size() == before.size(), "optimised doesn't compile: " + optimised);
+    if (before.empty() || after.size() != before.size()) return optimised;
+
+    std::size_t at = 0;
+    while (at < before.size() && closeEnough(before[at], after[at])) ++at;
+    CHECK_CASE(at == before.size(), source + "\n    => " + optimised + "\n    first difference at sample " + std::to_string(at));
+    return optimised;
+}
+
+// The same, played the way LMMS runs the text: each var statement on every
+// sample, each ternary evaluating only its chosen arm
+static std::vector<float> play(const std::string &source, double duration) {
+    ExprTree tree;
+    if (!ExprTree::parse(source, tree)) return {};
+    ScalarReference reference(tree, ExprProgram::kLanes);
+    reference.inputs.frequency = 220.0;
+    reference.inputs.knobs[0] = 0.3;
+    return reference.render((int)((duration > 0.0 ? duration : 2.0) / kDt) + 1, 0.0, kDt);
+}
+
+static void checkStatements(const std::string &source, const std::string &optimised, double duration) {
+    const std::vector<float> before = play(source, duration);
+    const std::vector<float> after = play(optimised, duration);
+    CHECK_CASE(!before.empty() && after.size() == before.size(), source + "\n    => " + optimised);
+    if (before.empty() || after.size() != before.size()) return;
+    std::size_t at = 0;
+    while (at < before.size() && closeEnough(before[at], after[at])) ++at;
+    CHECK_CASE(at == before.size(), source + "\n    => " + optimised + "\n    played differently from sample " + std::to_string(at));
+}
+
+static std::string simplified(const std::string &source, double duration = 0.0) {
+    ExprOptimizeOptions options;
+    options.duration = duration;
+    return checkPreserved(source, options);
+}
+
+static std::string hoisted(const std::string &source, double duration = 0.0) {
+    ExprOptimizeOptions options;
+    options.duration = duration;
+    options.hoistCommon = true;
+    return checkPreserved(source, options);
+}
+
+static int count(const std::string &text, const std::string &part) {
+    int found = 0;
+    for (std::size_t at = text.find(part); at != std::string::npos; at = text.find(part, at + part.size())) ++found;
+    return found;
+}
+
+// --- SIMPLIFICATION ---
+static void testRewrites() {
+    const struct { const char *source; double duration; const char *expected; } cases[] = {
+        { "(1.0000 * sinew(integrate(f))) * exp(-t * 0)", 0.0, "sinew(integrate(f))" },
+        { "(1 - 0 * exp(-t * 20)) * squarew(integrate(f))", 0.0, "squarew(integrate(f))" },
+        { "t ^ 2 + t ^ 1 + pow(t, 0)", 0.0, "t * t + t + 1" },
+        { "--t", 0.0, "t" },
+        { "0 - sinew(t) + (t - 0) + (0 + t)", 0.0, "-sinew(t) + t + t" },
+        { "1 + 2 * 3", 0.0, "7" },
+        { "(t > 0.5) ? 1 : 0", 0.0, "t > 0.5" },
+        // Never folded: LMMS computes randv differently, and state is state
+        { "randv(3) + sinew(0.25) + semitone(12) * t", 0.0, "randv(3) + 1 + 2 * t" },
+        { "sinew(integrate(440)) * 1", 0.0, "sinew(integrate(440))" },
+        // t is never negative
+        { "t < 0 ? 5 : 6", 0.0, "6" },
+        // Branches for times past the end of the sound go
+        { "(t < 0.5 ? sinew(t * 440) : (t < 0.9 ? 1 : 2))", 0.5, "(t < 0.5 ? sinew(t * 440) : 1)" },
+        // ... but not one the printed boundary only rounds past
+        { "t < 0.3 ? 1 : (t < 0.5 ? 2 : 3)", 0.5, "(t < 0.3 ? 1 : (t < 0.5 ? 2 : 3))" },
+    };
+    for (const auto &c : cases) {
+        const std::string result = simplified(c.source, c.duration);
+        CHECK_CASE(result == c.expected, std::string(c.source) + " => " + result);
+    }
+}
+
+// Texts the generators actually produce
+static void testGeneratorShapes() {
+    simplified("clamp(-1, (t < 0.3000 ? (sinew(integrate(f)) * min(1, (t - 0) * 120) * min(1, (0.3 - t) * 120)) : "
+               "(t < 0.5000 ? (saww(integrate(f)) * min(1, (t - 0.3) * 120) * min(1, (0.5 - t) * 120)) : 0)), 1)", 0.5);
+    simplified("((t >= 0 & t < 0.25) * sinew(t * 100)) + ((t >= 0.25 & t < 0.5) * saww(t * 100)) + ((t >= 0.7 & t < 0.9) * t)", 0.5);
+    simplified("var x := 3; var y := t * 2; y * 1 + y / 4 + y / 3 + (y - 0)");
+    simplified("var s := floor(t * 8000);\n((s <= 5) ? (0.1) : ((s <= 10) ? (0.2) : (0.3)))");
+    simplified("min(1, t / 0) * exp(-t * 3)");
+    simplified("(t < 0.2) & 1 | 0");
+}
+
+// A var statement with state in it stays a statement: moved into a ternary
+// arm, its integrate() would only advance while the arm is taken
+static void testStatements() {
+    const struct { const char *source; const char *expected; } cases[] = {
+        { "var p := integrate(1); t < 1 ? 0 : p", "var p := integrate(1);\n(t < 1 ? 0 : p)" },
+        { "var p := integrate(1) * 1; t < 1 ? 0 : p + 0", "var p := integrate(1);\n(t < 1 ? 0 : p)" },
+        { "var p := sinew(integrate(f)); var q := p * 2; t < 0.5 ? q : 0", "var p := sinew(integrate(f));\n(t < 0.5 ? p * 2 : 0)" },
+        { "var p := last(3); t < 1 ? p : 0", "var p := last(3);\n(t < 1 ? p : 0)" },
+        // Nothing stateful: inlining is safe
+        { "var x := t * 2; t < 1 ? x : 0", "(t < 1 ? t * 2 : 0)" },
+    };
+    for (const auto &c : cases) {
+        for (bool hoist : { false, true }) {
+            ExprOptimizeOptions options;
+            options.hoistCommon = hoist;
+            const std::string result = checkPreserved(c.source, options);
+            CHECK_CASE(result == c.expected, std::string(c.source) + " => " + result);
+            checkStatements(c.source, result, options.duration);
+        }
+    }
+    ExprOptimizeOptions options;
+    options.hoistCommon = true;
+    const char *const sources[] = {
+        "var p := integrate(1); (t < 1 ? 0 : p) + (t < 1 ? 0 : integrate(1))",
+        "var p := integrate(f); var q := integrate(f); sinew(t * 331) > 0 ? sinew(p) : saww(q)",
+        "var s := floor(t * 8000); var e := last(200); s <= 4000 ? e * 0.5 + sinew(t * 440) : (s <= 12000 ? e : 0)",
+    };
+    for (const char *source : sources) checkStatements(source, checkPreserved(source, options), 0.0);
+}
+
+// Text the parser can't model goes out untouched
+static void testUnparsed() {
+    CHECK(optimizeSource("sinew(t) + foo(3)") == "sinew(t) + foo(3)");
+    CHECK(optimizeSource("") == "");
+}
+
+// Whether any subexpression, run on its own, goes infinite or NaN; x * 0 = 0
+// and the like may change those sources (see exproptimize.h)
+static bool goesNonFinite(const std::string &source, double duration) {
+    ExprTree tree;
+    if (!ExprTree::parse(source, tree)) return true;
+    for (std::size_t i = 0; i < tree.nodes.size(); ++i) {
+        ExprTree subtree = tree;
+        subtree.root = (std::int32_t)i;
+        const std::vector<float> samples = render(ExprProgram::fromTree(subtree), duration);
+        if (std::any_of(samples.begin(), samples.end(), [](float x) { return !std::isfinite(x); })) return true;
+    }
+    return false;
+}
+
+static void testRandom() {
+    RandomExpression random(31337);
+    int checked = 0;
+    for (int i = 0; i < 400; ++i) {
+        const std::string source = random.next(5);
+        const double duration = (i % 2) ? 0.6 : 0.0;
+        if (goesNonFinite(source, duration)) continue;
+        simplified(source, duration);
+        ++checked;
+    }
+    CHECK(checked > 200);
+}
+
+// --- SHARING ---
+static void testHoisting() {
+    const struct { const char *source; const char *expected; } cases[] = {
+        { "sinew(integrate(f)) + sinew(integrate(f)) * (t * 3 + 1) - (t * 3 + 1)",
+          "var cse1 := sinew(integrate(f));\nvar cse2 := t * 3 + 1;\ncse1 + cse1 * cse2 - cse2" },
+        { "(t * 3 + 1) * (t * 3 + 1)", "var cse1 := t * 3 + 1;\ncse1 * cse1" },
+        // Inputs and numbers are as cheap to read as a var
+        { "t * t + f", "t * t + f" },
+        // Each arm's integrate() only accumulates while its arm is taken, so
+        // the condition is shared but the call sites aren't
+        { "(t < 0.5 ? integrate(1) : 0) + (t < 0.5 ? integrate(1) : 0)",
+          "var cse1 := t < 0.5;\n(cse1 ? integrate(1) : 0) + (cse1 ? integrate(1) : 0)" },
+    };
+    for (const auto &c : cases) {
+        const std::string result = hoisted(c.source);
+        CHECK_CASE(result == c.expected, std::string(c.source) + " => " + result);
+    }
+
+    // Two integrate()s in arms that disagree: merging them would make both
+    // advance on every sample
+    const std::string arms = hoisted("(sinew(t * 331) > 0 ? integrate(f) : 0) + (sinew(t * 331) > 0 ? 0 : integrate(f))");
+    CHECK_CASE(count(arms, "integrate(") == 2, arms);
+    hoisted("var p := integrate(f); (t < 0.3 ? sinew(p) : saww(p)) + (t < 0.3 ? sinew(p) : 0)", 0.6);
+}
+
+// The Serge fold pastes its input into every stage three times, so the text
+// grows 3^stages; shared, each stage reads the previous one
+static void testSergeFold() {
+    std::string folder = "(sinew(integrate(f + (2 * sinew(integrate(f * 1.5))))) * 1.5 + 0.1)";
+    for (int i = 0; i < 5; ++i) {
+        const std::string thresh = std::to_string(0.2 + i * 0.1);
+        folder = "(" + folder + " - 2*clamp(-" + thresh + ", " + folder + ", " + thresh + "))";
+    }
+    const std::string source = "clamp(-1, (" + folder + " * exp(-t * 15)), 1)";
+    const std::string result = hoisted(source, 1.0);
+    CHECK_CASE(result.size() * 8 < source.size(), std::to_string(source.size()) + " => " + std::to_string(result.size()));
+    CHECK_CASE(count(result, "integrate(") == 2, result);
+}
+
+static void testRandomHoisting() {
+    RandomExpression random(4242);
+    int checked = 0;
+    for (int i = 0; i < 300; ++i) {
+        // Repeats, as generators paste them
+        const std::string part = random.next(3);
+        const std::string source = "(" + part + ") * 0.5 + " + random.next(3) + " - (" + part + ")";
+        const double duration = (i % 2) ? 0.6 : 0.0;
+        if (goesNonFinite(source, duration)) continue;
+        hoisted(source, duration);
+        ++checked;
+    }
+    CHECK(checked > 150);
+}
+
+int main() {
+    testRewrites();
+    testGeneratorShapes();
+    testStatements();
+    testUnparsed();
+    testRandom();
+    testHoisting();
+    testSergeFold();
+    testRandomHoisting();
+    return checkResult();
+}
@@ -0,0 +1,159 @@
+#include "check.h"
+#include "exprtree.h"
+#include <clocale>
+#include <string>
+
+// --- HELPERS ---
+static std::string print(const std::string &source) {
+    ExprTree tree;
+    ExprParseError error;
+    if (!ExprTree::parse(source, tree, &error)) return "ERROR " + error.message;
+    return tree.toSource();
+}
+
+static double number(const std::string &source) {
+    ExprTree tree;
+    if (!ExprTree::parse(source, tree) || tree.nodes[tree.root].op != ExprNode::Const) return -12345.0;
+    return tree.nodes[tree.root].value;
+}
+
+// --- ROUND TRIPS ---
+// toSource() prints only the parentheses it needs, and what it prints parses
+// back to the same tree
+static void testRoundTrips() {
+    const struct { const char *source, *printed; } cases[] = {
+        { "(t + f) * v", "(t + f) * v" },
+        { "t - (f - v)", "t - (f - v)" },
+        { "t - f - v", "t - f - v" },
+        { "2 ^ 3 ^ t", "2 ^ (3 ^ t)" },
+        { "(2 ^ 3) ^ t", "(2 ^ 3) ^ t" },
+        { "-t ^ 2", "-(t ^ 2)" },
+        { "(-t) ^ 2", "(-t) ^ 2" },
+        { "t < 0.5 ? 1 : t > 2 ? 3 : 4", "(t < 0.5 ? 1 : (t > 2 ? 3 : 4))" },
+        { "(t < 0.5 ? 1 : 2) + 1", "(t < 0.5 ? 1 : 2) + 1" },
+        { "not(t) and f or v", "not(t) & f | v" },
+        { "t <> f", "t != f" },
+        { "t = f", "t == f" },
+        { "t % 2", "mod(t, 2)" },
+        { "mod(t, 2) + pow(t, 3)", "mod(t, 2) + t ^ 3" },
+        { "min(t, f, v)", "min(min(t, f), v)" },
+        { "clamp(-1, t, 1)", "clamp(-1, t, 1)" },
+        { "-0.5 * t", "-0.5 * t" },
+        { "t * -2", "t * -2" },
+        { "- (t * 2)", "-(t * 2)" },
+        { "sinew(integrate(f)) * last(64)", "sinew(integrate(f)) * last(64)" },
+        { "A1 * rel + trel * key / srate * tempo", "A1 * rel + trel * key / srate * tempo" },
+        { "// comment\nt # another\n /* block */ + 1", "t + 1" },
+        { "var x := t * 2; x + x", "var x := t * 2;\nx + x" },
+        { "var x := t * 2; x", "t * 2" },
+        // Inlined into the arm, the integrate() would only run with it
+        { "var p := integrate(1); t < 1 ? 0 : p", "var p := integrate(1);\n(t < 1 ? 0 : p)" },
+        { "var p := last(3) * 2; t < 1 ? p : 0", "var p := last(3) * 2;\n(t < 1 ? p : 0)" },
+        { "var x := 1; x := x + t; x * x", "var x := 1 + t;\nx * x" },
+    };
+    for (const auto &c : cases) {
+        const std::string printed = print(c.source);
+        CHECK_CASE(printed == c.printed, std::string(c.source) + " -> " + printed);
+        CHECK_CASE(print(printed) == printed, printed);
+    }
+}
+
+// --- NUMBERS ---
+static void testNumbers() {
+    CHECK(number("0.1") == 0.1);
+    CHECK(number("1e-300") == 1e-300);
+    CHECK(number("2E+2") == 200.0);
+    CHECK(number("1.e2") == 100.0);
+    CHECK(number(".25") == 0.25);
+    CHECK(number("pi") == 3.14159265358979323846);
+    CHECK(number("true") == 1.0);
+
+    // Shortest text that reads back as the same double
+    CHECK(print("0.30000000000000004") == "0.30000000000000004");
+    CHECK(print("0.841471") == "0.841471");
+    CHECK(print("8000") == "8000");
+    CHECK(print("1e-300") == "1e-300");
+    CHECK(print("0.1 + 0.2") == "0.1 + 0.2");
+}
+
+// Xpressive text uses '.' whatever the C locale says
+static void testLocale() {
+    const char *commaLocales[] = { "de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "fr_FR.utf8", "de_DE", "German" };
+    const char *chosen = nullptr;
+    for (const char *name : commaLocales) {
+        if (std::setlocale(LC_NUMERIC, name) && *std::localeconv()->decimal_point == ',') {
+            chosen = name;
+            break;
+        }
+    }
+    if (!chosen) std::printf("no comma-decimal locale installed; checking under the C locale only\n");
+
+    CHECK(number("0.5") == 0.5);
+    CHECK(number("1.5e-3") == 1.5e-3);
+    CHECK(print("0.5 * t + 0.25") == "0.5 * t + 0.25");
+    CHECK(print("1.5e-3") == "0.0015");
+    std::setlocale(LC_NUMERIC, "C");
+}
+
+// --- STATEMENTS ---
+// The scope generators write `(var s := ...; tree)`
+static void testBracketStatements() {
+    CHECK(print("2 * (var a := t * 3; var b := a * a; b - a) + 1") == "var a := t * 3;\n2 * (a * a - a) + 1");
+    CHECK(print("(var s := floor(t * 4); s <= 1 ? 0.5 : 0.25)") == "(floor(t * 4) <= 1 ? 0.5 : 0.25)");
+    CHECK(print("var x := 2; (var y := x + t; y * y) + x") == "var x := 2;\nvar y := x + t;\ny * y + x");
+    CHECK(print("(var a := 1)") == "ERROR expected ';' after 'var a'");
+    CHECK(print("(var sin := 1; 2)") == "ERROR 'sin' is a reserved name");
+    CHECK(print("t * (var a = 1; a)") == "ERROR expected ':=' after 'var a'");
+}
+
+// --- ERRORS ---
+static void testErrors() {
+    const struct { const char *source; std::size_t position; const char *message; } cases[] = {
+        { "sin(1, 2)", 0, "sin() takes 1 argument" },
+        { "foo(t)", 0, "unknown function 'foo'" },
+        { "t +", 3, "unexpected end of expression" },
+        { "(t", 0, "unclosed '('" },
+        { "t)", 1, "unmatched ')'" },
+        { "q", 0, "unknown variable 'q'" },
+        { "var t := 1; t", 4, "'t' is a reserved name" },
+        { "t : 1", 2, "':' without '?'" },
+        { "", 0, "empty expression" },
+    };
+    for (const auto &c : cases) {
+        ExprTree tree;
+        ExprParseError error;
+        CHECK_CASE(!ExprTree::parse(c.source, tree, &error), c.source);
+        CHECK_CASE(error.position == c.position && error.message == c.message,
+                   std::string(c.source) + ": " + std::to_string(error.position) + " " + error.message);
+        CHECK_CASE(!tree.isValid(), c.source);
+    }
+}
+
+// Parsing and printing never recurse, so nesting far beyond any call stack is fine
+static void testDeepNesting() {
+    const int depth = 200000;
+    std::string source(depth, '(');
+    source += "t";
+    for (int i = 0; i < depth; ++i) source += " + 1)";
+    ExprTree tree;
+    CHECK(ExprTree::parse(source, tree));
+    CHECK((int)tree.nodes.size() >= depth);
+    const std::string printed = tree.toSource();
+    CHECK(printed.compare(0, 7, "t + 1 +") == 0);
+
+    std::string ternary;
+    for (int i = 0; i < depth; ++i) ternary += "t < " + std::to_string(i) + " ? " + std::to_string(i) + " : ";
+    ternary += "-1";
+    CHECK(ExprTree::parse(ternary, tree));
+    CHECK(print(tree.toSource()) == tree.toSource());
+}
+
+int main() {
+    testRoundTrips();
+    testNumbers();
+    testLocale();
+    testBracketStatements();
+    testErrors();
+    testDeepNesting();
+    return checkResult();
+}
@@ -0,0 +1,317 @@
+#include "check.h"
+#include "randomexpression.h"
+#include "scalarreference.h"
+#include "exprvm.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+// --- HELPERS ---
+static const double kDt = 1.0 / 44100.0;
+
+static bool sameSample(float a, float b) {
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+// Index of the first sample where the two renders differ, or -1
+static int firstDifference(const std::vector<float> &a, const std::vector<float> &b) {
+    if (a.size() != b.size()) return 0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (!sameSample(a[i], b[i])) return (int)i;
+    }
+    return -1;
+}
+
+static ExprInputs testInputs() {
+    ExprInputs inputs;
+    inputs.frequency = 220.0;
+    inputs.velocity = 0.8;
+    inputs.knobs[0] = 0.3;
+    return inputs;
+}
+
+// Renders frames in calls of chunk samples, so state has to carry across them
+template <typename Renderer>
+static std::vector<float> renderChunks(Renderer render, int frames, double t0, int chunk) {
+    std::vector<float> out((std::size_t)frames);
+    for (int done = 0; done < frames; done += chunk) {
+        const int n = std::min(chunk, frames - done);
+        render(out.data() + done, n, t0 + done * kDt);
+    }
+    return out;
+}
+
+// Compares the VM with the scalar reference on one source
+static void checkAgainstReference(const std::string &source, int frames = 6000, double t0 = -0.01) {
+    ExprTree tree;
+    ExprParseError error;
+    if (!ExprTree::parse(source, tree, &error)) {
+        CHECK_CASE(false, "doesn't parse: " + source + ": " + error.message);
+        return;
+    }
+    const std::shared_ptr<const ExprProgram> program = ExprProgram::fromTree(tree);
+    CHECK_CASE(program != nullptr, source);
+    if (!program) return;
+
+    // One call, and calls that don't line up with the block length
+    for (int chunk : { frames, 1000, 37 }) {
+        ScalarReference reference(tree, program->blockLimit());
+        reference.inputs = testInputs();
+        const std::vector<float> expected = renderChunks([&](float *out, int n, double start) {
+            const std::vector<float> samples = reference.render(n, start, kDt);
+            std::copy(samples.begin(), samples.end(), out);
+        }, frames, t0, chunk);
+
+        ExprVM vm(program);
+        vm.setInputs(testInputs());
+        const std::vector<float> actual = renderChunks([&](float *out, int n, double start) {
+            vm.render(out, n, start, kDt);
+        }, frames, t0, chunk);
+
+        const int at = firstDifference(actual, expected);
+        CHECK_CASE(at < 0, source + " (chunks of " + std::to_string(chunk) + ") sample " + std::to_string(at)
+                               + ": " + std::to_string(at < 0 ? 0.0f : actual[(std::size_t)at]) + " vs "
+                               + std::to_string(at < 0 ? 0.0f : expected[(std::size_t)at]));
+    }
+}
+
+// --- STATELESS ---
+static void testOperators() {
+    const char *const sources[] = {
+        "0.5", "t", "-t", "1 - t", "3 / (t + 1)", "0.2 < t", "t <= 0.01", "t == 0", "t != 0",
+        "not(t > 0.01) or t < 0.005", "(t > 0.01 & t < 0.02) * saww(t * 100) + 2 * t",
+        "mod(t, 0.01) * 10 + 2 ^ t", "semitone(12) * trianglew(t * 7) * squarew(t * 3)",
+        "floor(t * 10) + ceil(t * 7) + trunc(-t * 5) + round(t * 3)", "min(t, 0.1) + max(t, sinew(t))",
+        "clamp(A1, t, 0.4)", "clamp(0 / 0, t, 0.4)", "sgn(t - 0.01)", "atan2(t, 0.3) + randsv(t * 100, 3) + randv(t * 1000)",
+        "log(t) + exp(t) + tan(t)", "abs(sinew(t)) + sqrt(t)", "t * f / srate * key / v + tempo + rel + trel",
+        "var x := t * 3; var y := x * x; y - x + y * x", "min(t / 0, 0.1)", "max(0 / 0, t)",
+    };
+    for (const char *source : sources) checkAgainstReference(source);
+}
+
+// Mixed blocks run both arms and blend; uniform blocks run one
+static void testTernaries() {
+    const char *const sources[] = {
+        "t < 0.025 ? 1 : -1",
+        "sinew(t * 331) > 0 ? t : -t",
+        "t > 0.01 ? (t < 0.02 ? 1 : 2) : (t > -0.005 ? 3 : 4)",
+        "sinew(t * 331) > 0 ? (saww(t * 97) < 0 ? sin(t) : cos(t)) : (t < 0.05 ? 5 : 6)",
+        "var s := floor((t + 0.01) * 8000); s <= 100 ? s / 1000 : (s <= 300 ? 1 - s / 300 : 0.5)",
+        "(sinew(t * 331) > 0 ? 1 : 0) + (sinew(t * 331) > 0 ? 2 : 0)",
+    };
+    for (const char *source : sources) checkAgainstReference(source);
+}
+
+// An integrate() in an arm only advances on the samples that select that arm,
+// also when the block's lanes disagree and both arms run
+static void testIntegrateUnderTernary() {
+    const char *const sources[] = {
+        "t < 0.01 ? sinew(integrate(440)) : sinew(integrate(880))",
+        "(t * 100 - floor(t * 100)) < 0.5 ? integrate(1) : -integrate(2)",
+        "sinew(t * 7) > 0 ? (sinew(t * 13) > 0 ? integrate(f) : integrate(2 * f)) : integrate(3)",
+        "squarew(t * 331) == 1 ? sinew(integrate(f)) : saww(integrate(f * 1.5))",
+        "var p := integrate(f); t < 0.02 ? sinew(p) : saww(p)",
+        // Read once, in one arm: the var statement still runs every sample
+        "var p := integrate(1); t < 1 ? 0 : p",
+        "var p := integrate(1); t < 0.01 ? 0 : p",
+        "var p := sinew(integrate(f)); sinew(t * 331) > 0 ? p : 0",
+        "sinew(t * 331) > 0 ? integrate(1) + integrate(2) : 0",
+    };
+    for (const char *source : sources) checkAgainstReference(source);
+
+    // LMMS plays 1.5 at t = 1.5 here, not the half second since the arm was taken
+    std::vector<float> out(2000);
+    ExprVM vm(ExprProgram::fromSource("var p := integrate(1); t < 1 ? 0 : p"));
+    vm.render(out.data(), 2000, 0.0, 1.0 / 1000.0);
+    CHECK(out[999] == 0.0f);
+    CHECK_CASE(std::fabs(out[1500] - 1.5f) < 1e-6f, std::to_string(out[1500]));
+}
+
+// --- STATE ---
+static std::shared_ptr<const ExprProgram> program(const std::string &source) {
+    return ExprProgram::fromSource(source);
+}
+
+// Blocks never run past the nearest last() offset, and the history only holds
+// what the offsets reach
+static void testStateLayout() {
+    CHECK(program("sinew(t)")->isStateless());
+    CHECK(program("sinew(t)")->historyLength() == 0);
+    CHECK(program("sinew(t)")->blockLimit() == ExprProgram::kLanes);
+    CHECK(!program("integrate(f)")->isStateless());
+    CHECK(program("integrate(f)")->blockLimit() == ExprProgram::kLanes);
+    CHECK(program("last(1)")->blockLimit() == 1);
+    CHECK(program("last(64)")->blockLimit() == 64);
+    CHECK(program("last(200)")->blockLimit() == ExprProgram::kLanes);
+    CHECK(program("last(200) + last(3)")->blockLimit() == 3);
+    CHECK(program("last(100)")->historyLength() == 128);
+    CHECK(program("last(200)")->historyLength() == 256);
+    CHECK(program("last(t * 10)")->blockLimit() == 1);
+    CHECK(program("last(t * 10)")->historyLength() == ExprProgram::kMaxHistory);
+}
+
+// An impulse echoed by last(n) lands exactly n samples later, whatever the
+// block length and however the frames are split across render calls
+static void testLastEcho() {
+    for (int offset : { 1, 3, 100, 127, 128, 129, 300 }) {
+        const std::string source = "t <= 0 ? 1 : last(" + std::to_string(offset) + ")";
+        const std::shared_ptr<const ExprProgram> echo = program(source);
+        for (int chunk : { 2000, 128, 37, 1 }) {
+            ExprVM vm(echo);
+            std::vector<float> out(2000);
+            for (int done = 0; done < 2000; done += chunk) {
+                const int n = std::min(chunk, 2000 - done);
+                vm.render(out.data() + done, n, done * kDt, kDt);
+            }
+            int wrong = 0;
+            for (int i = 0; i < 2000; ++i) wrong += out[(std::size_t)i] != (i % offset == 0 ? 1.0f : 0.0f);
+            CHECK_CASE(wrong == 0, source + " in chunks of " + std::to_string(chunk));
+        }
+    }
+}
+
+static void testStatefulAgainstReference() {
+    const char *const sources[] = {
+        "0.5 * last(1) + saww(t * 50)",
+        "0.9 * last(128) + sinew(t * 440) * (t < 0.02)",
+        "0.5 * last(129) + 0.25 * last(64) + squarew(t * 97)",
+        "0.7 * last(1 + floor(trianglew(t * 3) * 150)) + saww(t * 110)",
+        "sinew(integrate(f + 100 * sinew(integrate(3))))",
+        "sinew(t * 331) > 0 ? last(5) * 0.5 + integrate(1) : -last(200)",
+    };
+    for (const char *source : sources) checkAgainstReference(source);
+}
+
+// reset() is note-on: the same frames come out again
+static void testReset() {
+    ExprVM vm(program("sinew(integrate(f)) + 0.5 * last(7)"));
+    std::vector<float> first(3000), second(3000);
+    vm.render(first.data(), 3000, 0.0, kDt);
+    vm.reset();
+    vm.render(second.data(), 3000, 0.0, kDt);
+    CHECK(firstDifference(first, second) < 0);
+}
+
+// A knob ramp moves sample by sample inside a block, exactly as the same
+// ramp does in a ParametricSource
+static void testKnobRamp() {
+    const double rate = 1000.0;
+    ExprInputs inputs;
+    inputs.knobs[0] = 0.2;
+    ExpressionSource source(program("A1 * 2 + A3"), inputs);
+    ParametricSource expected([](double, const double *params) { return params[0] * 2 + params[2]; }, { 0.2, 0.0, 0.0 });
+    ParamCommand cmd;
+    cmd.value = 1.0f;
+    cmd.rampSeconds = 0.1f;
+    source.applyParameter(cmd, rate);
+    expected.applyParameter(cmd, rate);
+
+    std::vector<float> actual(300), wanted(300);
+    for (int done = 0; done < 300; done += 50) {
+        if (done == 150) {
+            cmd.slot = 2;
+            cmd.value = -0.5f;
+            cmd.rampSeconds = 0.03f;
+            source.applyParameter(cmd, rate);
+            expected.applyParameter(cmd, rate);
+        }
+        source.render(actual.data() + done, 50, done / rate, 1.0 / rate);
+        expected.render(wanted.data() + done, 50, done / rate, 1.0 / rate);
+    }
+    CHECK(firstDifference(actual, wanted) < 0);
+    CHECK(actual[0] != actual[1] && actual[48] != actual[49]);
+    CHECK(actual[299] == 1.5f);
+}
+
+// An O1/O2 pair plays each output as its own voice would, side by side
+static void testStereoSource() {
+    const std::shared_ptr<const ExprProgram> o1 = program("squarew(integrate(f)) * (mod(t * 8, 1) < 0.2) + A1");
+    const std::shared_ptr<const ExprProgram> o2 = program("0.5 * last(3) + squarew(integrate(f * 1.02)) * A1");
+    ExprInputs inputs = testInputs();
+    ExpressionSource stereo(o1, o2, inputs), mono(o1, o2, inputs);
+    ExpressionSource left(o1, inputs), right(o2, inputs);
+    CHECK(stereo.isStereo() && !left.isStereo());
+
+    ParamCommand cmd;
+    cmd.value = 0.9f;
+    cmd.rampSeconds = 0.01f;
+    for (AudioSource *source : { (AudioSource *)&stereo, (AudioSource *)&mono, (AudioSource *)&left, (AudioSource *)&right }) {
+        source->applyParameter(cmd, 1.0 / kDt);
+    }
+
+    std::vector<float> l(2000), r(2000), m(2000), wantL(2000), wantR(2000);
+    for (int done = 0; done < 2000; done += 500) {
+        const double t0 = done * kDt;
+        stereo.renderStereo(l.data() + done, r.data() + done, 500, t0, kDt);
+        mono.render(m.data() + done, 500, t0, kDt);
+        left.render(wantL.data() + done, 500, t0, kDt);
+        right.render(wantR.data() + done, 500, t0, kDt);
+    }
+    CHECK(firstDifference(l, wantL) < 0);
+    CHECK(firstDifference(r, wantR) < 0);
+    int wrong = 0;
+    for (int i = 0; i < 2000; ++i) wrong += m[(std::size_t)i] != 0.5f * (wantL[(std::size_t)i] + wantR[(std::size_t)i]);
+    CHECK(wrong == 0);
+}
+
+// Stateless sources render time ranges on several threads, one copy each
+static void testThreadCopies() {
+    const std::shared_ptr<const ExprProgram> wave = program("sinew(t * 440) * A1 + saww(t * 110)");
+    ExprInputs inputs = testInputs();
+    ExpressionSource source(wave, inputs);
+    CHECK(source.isStateless());
+    CHECK(!ExpressionSource(program("sinew(integrate(f))"), inputs).isStateless());
+    CHECK(!ExpressionSource(wave, program("last(1)"), inputs).isStateless());
+
+    const int frames = 4000, threads = 4, slice = frames / threads;
+    std::vector<float> want((std::size_t)frames), got((std::size_t)frames);
+    source.render(want.data(), frames, 0.0, kDt);
+
+    std::vector<std::unique_ptr<AudioSource>> copies;
+    std::vector<std::thread> workers;
+    for (int w = 0; w < threads; ++w) {
+        copies.push_back(source.cloneForThread());
+        AudioSource *copy = copies.back().get();
+        workers.emplace_back([copy, &got, w, slice]() {
+            copy->render(got.data() + w * slice, slice, w * slice * kDt, kDt);
+        });
+    }
+    for (std::thread &worker : workers) worker.join();
+    CHECK(firstDifference(got, want) < 0);
+
+    // A ramping knob moves with time rendered, so the source isn't stateless until it settles
+    ParamCommand cmd;
+    cmd.value = 0.9f;
+    cmd.rampSeconds = 0.01f;
+    source.applyParameter(cmd, 1.0 / kDt);
+    CHECK(!source.isStateless());
+    source.render(want.data(), frames, 0.0, kDt);
+    CHECK(source.isStateless());
+}
+
+static void testRandom() {
+    RandomExpression random(20240611);
+    random.stateful = false;
+    for (int i = 0; i < 300; ++i) checkAgainstReference(random.next(5), 1500);
+    random.stateful = true;
+    for (int i = 0; i < 300; ++i) checkAgainstReference(random.next(5), 1500);
+    random.lastRuntime = true;
+    for (int i = 0; i < 100; ++i) checkAgainstReference(random.next(5), 1500);
+}
+
+int main() {
+    testOperators();
+    testTernaries();
+    testIntegrateUnderTernary();
+    testStateLayout();
+    testLastEcho();
+    testStatefulAgainstReference();
+    testReset();
+    testKnobRamp();
+    testStereoSource();
+    testThreadCopies();
+    testRandom();
+    return checkResult();
+}
@@ -0,0 +1,90 @@
+#include "check.h"
+#include "voicemanager.h"
+#include <cmath>
+#include <vector>
+
+// --- HELPERS ---
+static const double kDt = 1.0 / 44100.0;
+
+static std::shared_ptr<const ExprProgram> compile(const std::string &source) {
+    std::string error;
+    std::shared_ptr<const ExprProgram> program = ExprProgram::fromSource(source, &error);
+    CHECK_CASE(program != nullptr, source + ": " + error);
+    return program;
+}
+
+static std::vector<float> render(AudioSource &source, int frames, double t0 = 0.0) {
+    std::vector<float> out((std::size_t)frames);
+    source.render(out.data(), frames, t0, kDt);
+    return out;
+}
+
+// --- COMPILED VOICES ---
+// Each voice is the program run on its own, with f set from its note
+static void testCompiledVoices() {
+    const std::shared_ptr<const ExprProgram> program = compile("sinew(integrate(f)) * exp(-t * 3)");
+    VoiceManager voices(program, ExprInputs(), 2);
+    voices.controller()->noteOn(220.0);
+    voices.controller()->noteOn(330.0, 0.5);
+
+    ExprInputs low, high;
+    low.frequency = 220.0;
+    high.frequency = 330.0;
+    ExpressionSource first(program, low), second(program, high);
+
+    // Odd block sizes, so each voice's state has to carry across calls
+    double t = 0.0;
+    for (int frames : { 300, 77, 1000 }) {
+        const std::vector<float> mixed = render(voices, frames, t);
+        const std::vector<float> a = render(first, frames, t), b = render(second, frames, t);
+        for (int i = 0; i < frames; ++i) CHECK_CASE(std::abs(mixed[i] - (a[i] + 0.5f * b[i])) < 1e-6f, std::to_string(i));
+        t += frames * kDt;
+    }
+    CHECK(voices.controller()->activeVoices() == 2);
+
+    // key follows the note
+    VoiceManager keys(compile("key"), ExprInputs(), 1);
+    keys.controller()->noteOn(880.0);
+    CHECK(std::abs(render(keys, 4)[3] - 81.0f) < 1e-4f);
+}
+
+// --- STEALING ---
+// With every voice busy, the oldest fades out before the new note starts
+static void testStealFade() {
+    VoiceManager voices(compile("f / 100"), ExprInputs(), 1);
+    voices.controller()->noteOn(100.0);
+    CHECK(render(voices, 512)[511] == 1.0f);
+
+    voices.controller()->noteOn(200.0);
+    const std::vector<float> fade = render(voices, 512);
+    const int fadeLength = (int)std::ceil(VoiceManager::kStealSeconds / kDt);
+    CHECK(fade[0] == 1.0f);
+    for (int i = 1; i < fadeLength; ++i) CHECK_CASE(fade[i] < fade[i - 1] && fade[i] > 0.0f, std::to_string(i));
+    CHECK(fade[fadeLength + 1] == 0.0f);
+    CHECK(render(voices, 512)[0] == 2.0f);
+
+    // A note released before its stolen voice came free never sounds
+    const int id = voices.controller()->noteOn(300.0);
+    voices.controller()->noteOff(id);
+    render(voices, 512);
+    CHECK(render(voices, 512)[0] == 0.0f);
+    CHECK(voices.controller()->activeVoices() == 0);
+}
+
+// Plain function patches fade the same way
+static void testStealFadeFunction() {
+    VoiceManager voices([](double, double f) { return f / 100.0; }, 1);
+    voices.controller()->noteOn(100.0);
+    render(voices, 256);
+    voices.controller()->noteOn(300.0);
+    const std::vector<float> fade = render(voices, 512);
+    CHECK(fade[0] == 1.0f && fade[50] < 1.0f && fade[50] > 0.0f);
+    CHECK(render(voices, 16)[0] == 3.0f);
+}
+
+int main() {
+    testCompiledVoices();
+    testStealFade();
+    testStealFadeFunction();
+    return checkResult();
+}
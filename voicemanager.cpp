@@ -0,0 +1,162 @@
+#include "voicemanager.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+// --- VOICE CONTROLLER ---
+int VoiceController::noteOn(double freq, double velocity) {
+    NoteEvent ev;
+    ev.type = NoteEvent::On;
+    ev.id = m_nextId++;
+    ev.freq = freq;
+    ev.velocity = velocity;
+    return m_events.push(ev) ? ev.id : -1;
+}
+
+void VoiceController::noteOff(int noteId) {
+    NoteEvent ev;
+    ev.type = NoteEvent::Off;
+    ev.id = noteId;
+    m_events.push(ev);
+}
+
+void VoiceController::allNotesOff() {
+    NoteEvent ev;
+    ev.type = NoteEvent::AllOff;
+    m_events.push(ev);
+}
+
+// --- VOICE MANAGER ---
+VoiceManager::VoiceManager(VoicePatch patch, int maxVoices, double releaseSeconds)
+    : m_patch(std::move(patch)),
+      m_controller(std::make_shared<VoiceController>()),
+      m_maxVoices(std::clamp(maxVoices, 1, kMaxVoices)),
+      m_releaseSeconds(std::max(releaseSeconds, 0.001)) {}
+
+VoiceManager::VoiceManager(std::shared_ptr<const ExprProgram> program, const ExprInputs &inputs, int maxVoices,
+                           double releaseSeconds)
+    : VoiceManager(VoicePatch(), maxVoices, releaseSeconds) {
+    m_inputs = inputs;
+    for (int v = 0; v < m_maxVoices; ++v) m_voices[v].vm = std::make_unique<ExprVM>(program);
+}
+
+VoiceManager::Voice &VoiceManager::allocateVoice() {
+    // Free voice first, otherwise steal the one that started earliest
+    Voice *oldest = &m_voices[0];
+    for (int v = 0; v < m_maxVoices; ++v) {
+        if (!m_voices[v].active) return m_voices[v];
+        if (m_voices[v].startOrder < oldest->startOrder) oldest = &m_voices[v];
+    }
+    return *oldest;
+}
+
+void VoiceManager::startNote(Voice &voice, const VoiceController::NoteEvent &ev) {
+    voice.active = true;
+    voice.releasing = false;
+    voice.stealing = false;
+    voice.hasPending = false;
+    voice.id = ev.id;
+    voice.t = 0.0;
+    voice.freq = ev.freq;
+    voice.velocity = ev.velocity;
+    voice.releaseGain = 1.0;
+    voice.startOrder = m_startCounter++;
+    if (voice.vm) {
+        ExprInputs inputs = m_inputs;
+        inputs.frequency = ev.freq;
+        if (ev.freq > 0.0) inputs.key = 69.0 + 12.0 * std::log2(ev.freq / 440.0);
+        voice.vm->setInputs(inputs);
+        voice.vm->reset();
+    }
+}
+
+void VoiceManager::handleEvents() {
+    VoiceController::NoteEvent ev;
+    while (m_controller->m_events.pop(ev)) {
+        switch (ev.type) {
+        case VoiceController::NoteEvent::On: {
+            Voice &voice = allocateVoice();
+            if (!voice.active) {
+                startNote(voice, ev);
+                break;
+            }
+            // Stolen: the note waits for the fade, and the voice is no longer the oldest
+            voice.stealing = true;
+            voice.hasPending = true;
+            voice.pending = ev;
+            voice.startOrder = m_startCounter++;
+            break;
+        }
+        case VoiceController::NoteEvent::Off:
+            for (int v = 0; v < m_maxVoices; ++v) {
+                Voice &voice = m_voices[v];
+                if (voice.active && voice.id == ev.id) voice.releasing = true;
+                if (voice.hasPending && voice.pending.id == ev.id) voice.hasPending = false;
+            }
+            break;
+        case VoiceController::NoteEvent::AllOff:
+            for (int v = 0; v < m_maxVoices; ++v) {
+                if (m_voices[v].active) m_voices[v].releasing = true;
+                m_voices[v].hasPending = false;
+            }
+            break;
+        }
+    }
+}
+
+void VoiceManager::renderVoice(Voice &voice, float *out, int frames, double t0, double dt) {
+    if (voice.vm) {
+        voice.vm->render(out, frames, t0, dt);
+        return;
+    }
+    for (int i = 0; i < frames; ++i) out[i] = (float)m_patch(t0 + i * dt, voice.freq);
+}
+
+void VoiceManager::render(float *out, int frames, double, double dt) {
+    handleEvents();
+    std::fill(out, out + frames, 0.0f);
+    if (!m_patch && !m_voices[0].vm) return;
+
+    const auto start = std::chrono::steady_clock::now();
+    const double releaseStep = dt / m_releaseSeconds;
+    const double stealStep = dt / kStealSeconds;
+    float chunk[ExprProgram::kLanes];
+    int voiceCount = 0;
+
+    for (int v = 0; v < m_maxVoices; ++v) {
+        Voice &voice = m_voices[v];
+        if (!voice.active) continue;
+        ++voiceCount;
+
+        // Linear fade when releasing or stolen; the voice frees itself once it reaches zero
+        const double vel = voice.velocity;
+        const double step = voice.stealing ? stealStep : voice.releasing ? releaseStep : 0.0;
+        double gain = voice.releaseGain;
+        for (int done = 0; done < frames && gain > 0.0; done += ExprProgram::kLanes) {
+            const int n = std::min(ExprProgram::kLanes, frames - done);
+            renderVoice(voice, chunk, n, voice.t + done * dt, dt);
+            if (step == 0.0) {
+                for (int i = 0; i < n; ++i) out[done + i] += (float)(chunk[i] * vel);
+                continue;
+            }
+            for (int i = 0; i < n && gain > 0.0; ++i) {
+                out[done + i] += (float)(chunk[i] * vel * gain);
+                gain -= step;
+            }
+        }
+        voice.releaseGain = gain;
+        voice.t += frames * dt;
+        if (gain <= 0.0) {
+            voice.active = false;
+            if (voice.hasPending) startNote(voice, voice.pending);
+        }
+    }
+
+    m_controller->m_activeVoices.store(voiceCount, std::memory_order_relaxed);
+    if (voiceCount > 0 && frames > 0) {
+        const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const float perVoice = (float)(elapsed / (frames * dt * voiceCount));
+        const float smoothed = m_controller->m_perVoiceLoad.load(std::memory_order_relaxed);
+        m_controller->m_perVoiceLoad.store(smoothed + 0.1f * (perVoice - smoothed), std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,102 @@
+#ifndef VOICEMANAGER_H
+#define VOICEMANAGER_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include "audiosource.h"
+#include "exprvm.h"
+#include "spscqueue.h"
+
+// ==============================================================================
+// POLYPHONIC VOICES
+// ==============================================================================
+// LMMS runs an Xpressive patch once per held note. VoiceManager does the same for
+// previews: each voice has its own t (seconds since note-on), f and release
+// envelope, and all voices are summed in one block pass. When every voice is
+// busy, the oldest one fades out over kStealSeconds before the new note takes
+// it over, rather than being cut mid-cycle.
+
+// Patch evaluated per voice: t = seconds since note-on, f = note frequency in Hz
+using VoicePatch = std::function<double(double t, double f)>;
+
+// --- VOICE CONTROLLER ---
+// GUI-side handle. Note events travel to the audio thread through an SPSC queue,
+// so it stays valid (and harmless) after the engine has replaced the source.
+class VoiceController {
+public:
+    int noteOn(double freq, double velocity = 1.0);
+    void noteOff(int noteId);
+    void allNotesOff();
+
+    int activeVoices() const { return m_activeVoices.load(std::memory_order_relaxed); }
+    // Render time of a single voice as a share of the real-time budget, in percent
+    double perVoiceLoad() const { return m_perVoiceLoad.load(std::memory_order_relaxed) * 100.0; }
+
+private:
+    friend class VoiceManager;
+
+    struct NoteEvent {
+        enum Type { On, Off, AllOff } type = On;
+        int id = 0;
+        double freq = 0.0;
+        double velocity = 1.0;
+    };
+
+    SpscQueue<NoteEvent, 256> m_events;
+    int m_nextId = 1;
+
+    std::atomic<int> m_activeVoices { 0 };
+    std::atomic<float> m_perVoiceLoad { 0.0f };
+};
+
+// --- VOICE MANAGER ---
+class VoiceManager : public AudioSource {
+public:
+    static constexpr int kMaxVoices = 32;
+    static constexpr double kStealSeconds = 0.005;
+
+    explicit VoiceManager(VoicePatch patch, int maxVoices = 8, double releaseSeconds = 0.08);
+    // A compiled patch: each voice runs it on its own ExprVM, with f and key set
+    // from its note and the other inputs as given. The VMs are all built here,
+    // so note-on on the audio thread only resets one.
+    explicit VoiceManager(std::shared_ptr<const ExprProgram> program, const ExprInputs &inputs = ExprInputs(),
+                          int maxVoices = 8, double releaseSeconds = 0.08);
+
+    std::shared_ptr<VoiceController> controller() const { return m_controller; }
+    void render(float *out, int frames, double t0, double dt) override;
+
+private:
+    struct Voice {
+        bool active = false;
+        bool releasing = false;
+        int id = 0;
+        double t = 0.0;
+        double freq = 0.0;
+        double velocity = 1.0;
+        double releaseGain = 1.0;
+        std::uint64_t startOrder = 0;
+        // Stolen: fading out, then the pending note starts in this voice
+        bool stealing = false;
+        bool hasPending = false;
+        VoiceController::NoteEvent pending;
+        std::unique_ptr<ExprVM> vm;     // Compiled patches only
+    };
+
+    void handleEvents();
+    Voice &allocateVoice();
+    void startNote(Voice &voice, const VoiceController::NoteEvent &ev);
+    // The patch's raw output for one voice, frames <= ExprProgram::kLanes
+    void renderVoice(Voice &voice, float *out, int frames, double t0, double dt);
+
+    VoicePatch m_patch;
+    ExprInputs m_inputs;
+    std::shared_ptr<VoiceController> m_controller;
+    Voice m_voices[kMaxVoices];
+    int m_maxVoices;
+    double m_releaseSeconds;
+    std::uint64_t m_startCounter = 0;
+};
+
+#endif // VOICEMANAGER_H